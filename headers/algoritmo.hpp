@@ -4,50 +4,364 @@
 
 #include <vector>
 #include <queue>
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <chrono>
+
+#include "heapIndexado.hpp"
+#include "landmarks.hpp"
+#include "estruturaD.hpp"
+
+// Combinaes de (Vertice, Peso) que os .cpp instanciam explicitamente.
+// Em plataformas 32 bits size_t j  uint32_t, ento a ltima combinao repetiria a primeira.
+#if SIZE_MAX > UINT32_MAX
+#define CAMINHOMINIMO_TIPOS(X) X(size_t, double) X(uint32_t, float) X(uint32_t, double)
+#else
+#define CAMINHOMINIMO_TIPOS(X) X(size_t, double) X(uint32_t, float)
+#endif
 
 // namespace feito para separar os algoritmos dos testes
 namespace CaminhoMinimo {
 	using Grafo = std::vector<std::vector<std::pair<size_t, double>>>;
-	using FilaPrioridade = std::priority_queue<std::pair<double, size_t>, std::vector<std::pair<double, size_t>>, std::greater<std::pair<double, size_t>>>;
+
+	template <typename Vertice, typename Peso>
+	using FilaPrioridade = std::priority_queue<std::pair<Peso, Vertice>, std::vector<std::pair<Peso, Vertice>>, std::greater<std::pair<Peso, Vertice>>>;
+
+	// Viso (sem posse) de um grafo em CSR.  o que os algoritmos percorrem, ento tanto um GrafoCSR
+	// em memria quanto um arquivo binrio mapeado (grafoBinario.hpp) podem ser usados sem cpia.
+	template <typename Vertice = size_t, typename Peso = double>
+	struct VisaoCSR {
+		std::span<const size_t> inicios; // n + 1 posies
+		std::span<const Vertice> destinos;
+		std::span<const Peso> pesos;
+
+		size_t tamanho() const { return inicios.empty() ? 0 : inicios.size() - 1; }
+		size_t numArestas() const { return destinos.size(); }
+	};
+
+	// Grafo em CSR (compressed sparse row): as arestas de u ficam contguas em [inicios[u], inicios[u + 1]).
+	// Evita uma alocao separada por vrtice, que  o que domina o tempo em grafos grandes.
+	// Com Vertice = uint32_t e Peso = float cada aresta ocupa 8 bytes em vez de 16.
+	template <typename Vertice = size_t, typename Peso = double>
+	struct GrafoCSR {
+		std::vector<size_t> inicios; // n + 1 posies
+		std::vector<Vertice> destinos;
+		std::vector<Peso> pesos;
+
+		size_t tamanho() const { return inicios.empty() ? 0 : inicios.size() - 1; }
+		size_t numArestas() const { return destinos.size(); }
+		VisaoCSR<Vertice, Peso> visao() const { return { inicios, destinos, pesos }; }
+	};
+
+	template <typename Vertice = size_t, typename Peso = double>
+	GrafoCSR<Vertice, Peso> converteParaCSR(const Grafo& grafo);
+
+	// Grafo com todas as arestas invertidas (u -> v vira v -> u, mesmo peso)
+	template <typename Vertice = size_t, typename Peso = double>
+	GrafoCSR<Vertice, Peso> transpoeGrafo(const VisaoCSR<Vertice, Peso>& grafo);
 
 	constexpr double PESOMAX = 100.0;
 
 #ifdef LIMPARUIDO
 	// funo que garante preciso quando fazemos operaes com pontos flutuantes
-	static double limpaRuido(double valor) {
-		constexpr double PRECISAO = 1e9;
+	template <typename Peso>
+	static Peso limpaRuido(Peso valor) {
+		constexpr Peso PRECISAO = static_cast<Peso>(1e9);
 		return std::round(valor * PRECISAO) / PRECISAO;
 	}
 #endif
 
+	// Fila de prioridades usada por execDijkstra. DAria  o heap indexado com decrease-key (heapIndexado.hpp),
+	// Binaria  FilaPrioridade com remoo preguiosa. Radix s aceita pesos no negativos (radixHeap.hpp);
+	// Dial usa a faixa de pesos medida em setGrafo (filaDial.hpp) e cai no Radix quando o menor peso  0
+	enum class FilaDijkstra { DAria, Binaria, Radix, Dial };
+
+	// Como o findPivots do BMSSP sabe se um vrtice j entrou na camada atual. Geracao troca de marca em O(1) por camada;
+	// Limpeza zera as n marcas a cada camada, como era antes, e s existe para comparar as duas (main camadas)
+	enum class MarcacaoCamadas { Geracao, Limpeza };
+
+	// Renumeraes de vrtices para localidade (reordenacao.hpp)
+	enum class Ordenacao { Nenhuma, BFS, RCM, Grau };
+
+	// Pr-processamentos opcionais aplicados em setGrafo. Mesmo com eles, a origem passada para exec*
+	// e as distncias de getDist continuam usando os ids do grafo original.
+	struct OpcoesPreprocessamento {
+		bool grauConstante = false; // divide vrtices de grau alto em ciclos de cpias (grauConstante.hpp)
+		size_t grauMaximo = 8;      // arestas originais de entrada/sada por cpia (padro justificado em grauConstante.hpp)
+		Ordenacao ordenacao = Ordenacao::Nenhuma; // aplicada depois da transformao de grau constante
+	};
+
+	// Parte imutvel de um Algoritmo: o grafo, o que setGrafo deriva dele e os parmetros do BMSSP. Fica atrs de um
+	// shared_ptr<const>, ento vrios Algoritmo (um por thread, ver compartilhaGrafo) consultam o mesmo grafo sem copi-lo
+	template <typename Vertice = size_t, typename Peso = double>
+	struct GrafoPreparado {
+		VisaoCSR<Vertice, Peso> visao; // aponta para armazenado ou para o grafo do chamador
+		GrafoCSR<Vertice, Peso> armazenado; // s  usado quando setGrafo recebe um Grafo ou opes
+		// Transposto de visao, para o Dijkstra bidirecional e as landmarks. S  montado no primeiro uso (exigeReverso),
+		// para setGrafo no gastar O(n + m) de tempo e memria a mais em quem nunca faz uma busca reversa
+		mutable GrafoCSR<Vertice, Peso> reverso;
+		mutable std::once_flag reversoPronto;
+		std::vector<Vertice> paraInterno; // id original -> id no grafo pr-processado (vazio se no houve pr-processamento)
+		std::vector<Vertice> paraOriginal; // id no grafo pr-processado -> id original
+		OpcoesPreprocessamento opcoes; // as de setGrafo; as padro quando no houve pr-processamento
+		long long tempoPreprocessamento = 0;
+		Peso pesoMinimo = 0, pesoMaximo = 0; // faixa dos pesos de visao (com as arestas de peso 0 entre cpias), para a fila Dial
+		size_t tamanho = 0, maxContagemK = 1, passosT = 1;
+		double logN = 0;
+	};
+
+	// Resultado da ltima busca de um Algoritmo sem cpia: aponta para as estruturas internas dele e vale at a prxima
+	// exec* ou setGrafo. distancia e caminho recebem e devolvem ids do grafo original
+	template <typename Vertice = size_t, typename Peso = double>
+	struct ResultadoBusca {
+		std::span<const Peso> dist; // por id interno, que  o original quando no h pr-processamento
+		std::span<const Vertice> predecessores; // idem; NULO nas origens e nos vrtices no alcanados
+		std::span<const Vertice> paraInterno; // vazios sem pr-processamento
+		std::span<const Vertice> paraOriginal;
+
+		Peso distancia(Vertice vertice) const { return dist[paraInterno.empty() ? vertice : paraInterno[vertice]]; }
+		// Vrtices da origem at alvo; vazio se alvo no foi alcanado. A verso com saida reaproveita a memria do vetor
+		void caminho(Vertice alvo, std::vector<Vertice>& saida) const;
+		std::vector<Vertice> caminho(Vertice alvo) const { std::vector<Vertice> saida; caminho(alvo, saida); return saida; }
+	};
+
+	// Algoritmo usado em cada busca de execLote
+	enum class MetodoLote { Dijkstra, BMSSP };
+
+	template <typename Vertice = size_t, typename Peso = double>
 	class Algoritmo {
 	public:
-		Algoritmo() : ptrGrafo(nullptr) {} // as variaveis so inicializadas em setGrafo j que elas dependem do tamanho do grafo.
+		Algoritmo() {} // as variaveis so inicializadas em setGrafo j que elas dependem do tamanho do grafo.
+
+		long long execDijkstra(Vertice origem);
+		long long execBmssp(Vertice origem);
+		// Consultas: param assim que todos os alvos tm distncia final. S as distncias dos alvos so garantidas
+		long long execDijkstra(Vertice origem, const std::vector<Vertice>& alvos);
+		long long execBmssp(Vertice origem, const std::vector<Vertice>& alvos);
+		// Vrias origens de uma vez, como se houvesse uma superorigem ligada a cada uma com peso deslocamentos[i]
+		// (vazio = todas 0; deslocamentos precisam ser no negativos). O grafo no  alterado
+		long long execDijkstra(const std::vector<Vertice>& origens, const std::vector<Peso>& deslocamentos = {});
+		long long execBmssp(const std::vector<Vertice>& origens, const std::vector<Peso>& deslocamentos = {});
+		// BMSSP em fatias, para intercalar uma busca longa com outras na mesma thread. iniciaBmssp prepara a busca (mesmos
+		// parmetros de execBmssp) e continuaBmssp avana at ela terminar, o tempo acabar ou maxPassos passos serem dados;
+		// devolve true quando terminou. O oramento  conferido depois de cada passo, ento toda fatia anda e dura no mximo o
+		// tempo pedido mais um passo. Um passo relaxa at ARESTASPORPASSO arestas (um pedao do findPivots ou das relaxaes
+		// depois da chamada de baixo) mais as operaes em D que elas disparam, ou  um pull, que custa O(M). O que no se
+		// divide  o fim de cada etapa: escolher os pivots e reiniciar D, o batchPrepend de todo o K e o pull de M = 2^{(l-1)t}
+		// perto da raiz. No esparso 20000 4 o maior passo medido fica em torno de 2 ms e a fatia de 1 ms chega a uns 2,5 ms.
+		// Outra exec* ou setGrafo no meio descarta a busca pausada
+		void iniciaBmssp(Vertice origem, const std::vector<Vertice>& alvos = {});
+		void iniciaBmssp(const std::vector<Vertice>& origens, const std::vector<Peso>& deslocamentos = {});
+		bool continuaBmssp(std::chrono::microseconds tempo = std::chrono::microseconds::max(), size_t maxPassos = std::numeric_limits<size_t>::max());
+		bool bmsspEmAndamento() const { return pilhaBmssp.nivelAtivo >= 0; }
+		// Busca de origem e de alvo (no grafo reverso) ao mesmo tempo. S getDist(alvo) e o caminho at alvo em getPredecessores so garantidos.
+		// A primeira chamada sobre um grafo (ou preprocessaLandmarks) monta o transposto dele, compartilhado com quem usa o mesmo grafo
+		long long execDijkstraBidirecional(Vertice origem, Vertice alvo);
+		// A* com os potenciais das landmarks (ALT). Precisa de preprocessaLandmarks ou carregaLandmarks antes; mesmas garantias do bidirecional
+		long long execAEstrela(Vertice origem, Vertice alvo);
+		// Delta-stepping paralelo (Meyer e Sanders); numThreads = 0 usa todos os ncleos
+		long long execDeltaStepping(Vertice origem, Peso delta, size_t numThreads = 0);
+		// Uma busca completa por origem, repartidas entre numThreads threads (0 = todos os ncleos) com roubo de trabalho.
+		// Cada thread usa um Algoritmo prprio que compartilha o grafo deste; consome(i, algoritmo)  chamado na thread que
+		// rodou origens[i], logo depois da busca, e precisa aceitar chamadas simultneas com i diferentes. Devolve o tempo total
+		using ConsumidorLote = std::function<void(size_t, const Algoritmo&)>;
+		long long execLote(const std::vector<Vertice>& origens, MetodoLote metodo, const ConsumidorLote& consome, size_t numThreads = 0) const;
 
-		long long execDijkstra(size_t origem);
-		long long execBmssp(size_t origem);
+		std::vector<Peso> getDist() const; // cpia em ids originais; para s ler, getResultado().distancia no copia nada
+		Peso getDist(Vertice vertice) const { return distD[paraInterno.empty() ? vertice : paraInterno[vertice]]; }
+		std::vector<Vertice> getPredecessores() const; // da ltima busca, em ids originais
+		ResultadoBusca<Vertice, Peso> getResultado() const { return { distD, predecessores, paraInterno, paraOriginal }; }
+		void setGrafo(const Grafo& grafo); // converte para CSR e guarda a cpia internamente
+		void setGrafo(const GrafoCSR<Vertice, Peso>& grafo); // usa o grafo do chamador sem copiar
+		void setGrafo(const VisaoCSR<Vertice, Peso>& grafo); // idem, para grafos que no esto em um GrafoCSR (ex: arquivo mapeado)
+		void setGrafo(const VisaoCSR<Vertice, Peso>& grafo, const OpcoesPreprocessamento& opcoes); // guarda o grafo transformado internamente
+		// Passa a usar o grafo j preparado de outro (pr-processamento e landmarks inclusos) e a mesma configurao de filas.
+		// Nada do grafo  copiado; s as estruturas de cada busca (distD, heaps) so alocadas
+		void compartilhaGrafo(const Algoritmo& outro);
 
-		std::vector<double> getDist() { return distD; }
-		void setGrafo(const Grafo& grafo);
+		void setFilaDijkstra(FilaDijkstra fila) { filaDijkstra = fila; }
+		void setMarcacaoCamadas(MarcacaoCamadas marcacao) { areaBmssp.limpaCamadas = marcacao == MarcacaoCamadas::Limpeza; }
+		long long getTempoPreprocessamento() const { return grafoCompartilhado ? grafoCompartilhado->tempoPreprocessamento : 0; } // microssegundos do ltimo setGrafo com opes
 
-		static constexpr double INFINITO = std::numeric_limits<double>::infinity();
-		static constexpr size_t NULO = std::numeric_limits<size_t>::max();
+		// Escolhe numLandmarks vrtices por farthest-first e calcula as tabelas do ALT; numThreads = 0 usa todos os ncleos.
+		// Devolve o tempo em microssegundos. As tabelas usam os ids internos, ento valem s para o grafo e as opes atuais.
+		// Custa 2 Dijkstras completos por landmark e 2 * n * numLandmarks pesos de memria. O ALT compensa em grafos com geometria
+		// (grades, malhas virias), onde os limites da desigualdade triangular so justos: na grade 150x150 do main, 16
+		// landmarks rotulam 1/5 dos vrtices do Dijkstra com parada no alvo e a consulta cai para menos da metade do tempo.
+		// Em grafos aleatrios de dimetro pequeno (esparso, rmat) os limites so frouxos: com 16 landmarks o A* rotula 1/4
+		// dos vrtices, mas cada um l 2 linhas da tabela (fora do cache entre consultas variadas) e a consulta fica s 1,3x
+		// a 2x mais rpida. Nesses grafos o execDijkstraBidirecional, sem pr-processamento, chega a ser 10x mais rpido
+		long long preprocessaLandmarks(size_t numLandmarks, size_t numThreads = 0);
+		void salvaLandmarks(const std::string& caminho) const;
+		// Lana std::runtime_error se o arquivo no for deste grafo: confere tamanho, opes de pr-processamento e uma
+		// impresso digital de inicios, destinos e pesos do grafo preparado (cobre grafos do mesmo tamanho e renumeraes)
+		void carregaLandmarks(const std::string& caminho);
+
+		static constexpr Peso INFINITO = std::numeric_limits<Peso>::infinity();
+		static constexpr Vertice NULO = std::numeric_limits<Vertice>::max();
 	private:
-		// Os algoritmos em si
-		std::vector<size_t> dijkstra(size_t origem);
+		// Os algoritmos em si. Todos escrevem em distD e predecessores
+		void dijkstra(const std::vector<Vertice>& origens);
+		void dijkstraBidirecional(Vertice origem, Vertice alvo);
+		void emendaCaminho(Vertice encontro, Vertice alvo); // junta a rvore reversa (encontro -> alvo) em predecessores
+		void aEstrela(Vertice origem, Vertice alvo);
+		void deltaStepping(Vertice origem, Peso delta, size_t numThreads);
+
+		// O BMSSP no  recursivo: cada chamada  um quadro da pilhaBmssp e passoBmssp executa a prxima etapa do quadro do
+		// topo. iniciaPilhaBmssp empilha a chamada de nvel mais alto com as origens (j em ids internos) como S
+		void iniciaPilhaBmssp(std::vector<Vertice> origens);
+		void empilhaBmssp(int nivel, Peso limiteB);
+		void passoBmssp();
+		// S de uma chamada e o vetor onde ela acrescenta U so buffers do nvel de cima (ou os da raiz), ento a chamada de
+		// baixo l a fronteira sem cpia e devolve U direto no vetor de quem chamou
+		std::span<const Vertice> fronteiraDoNivel(int nivel) const {
+			return nivel == pilhaBmssp.nivelRaiz ? std::span<const Vertice>(areaBmssp.origensRaiz) : std::span<const Vertice>(areaBmssp.niveis[nivel + 1].fronteiraLote);
+		}
+		std::vector<Vertice>& resolvidosDoNivel(int nivel) {
+			return nivel == pilhaBmssp.nivelRaiz ? areaBmssp.resolvidosRaiz : areaBmssp.niveis[nivel + 1].resolvidosLote;
+		}
 
-		std::pair<double, std::vector<size_t>> bmssp(int nivel, double limiteSuperiorGlobalB, std::vector<size_t> fronteiraS);
+		void findPivots(Peso limiteB, std::span<const Vertice> fronteiraInicialS, std::vector<Vertice>& pivots, std::vector<Vertice>& verticesAlcancadosW);
+		// devolve B' e acrescenta U em resolvidosU
+		Peso baseCase(Peso limiteB, Vertice pivoFonteS, std::vector<Vertice>& resolvidosU);
+		void escolhePivots(std::span<const Vertice> fronteiraS, const std::vector<Vertice>& verticesAlcancadosW, std::vector<Vertice>& pivots);
 
-		std::pair<std::vector<size_t>, std::vector<size_t>> findPivots(double limiteB, std::vector<size_t> fronteiraInicialS);
-		std::pair<double, std::vector<size_t>> baseCase(double limiteB, size_t pivoFonteS);
+		void exigeGrafo(const char* funcao) const; // std::logic_error se ainda no houve setGrafo / compartilhaGrafo
+		void exigeReverso(); // monta o transposto do grafo compartilhado na primeira vez e aponta visaoReversa para ele
+		void defineAlvos(const std::vector<Vertice>& alvos);
+		// zera distD, coloca o deslocamento de cada origem e devolve as origens em ids internos, sem repetio
+		std::vector<Vertice> inicializaOrigens(const std::vector<Vertice>& origens, const std::vector<Peso>& deslocamentos);
+		void ajustaRepresentantes(Vertice alvo);
+		void associaGrafo(std::shared_ptr<const GrafoPreparado<Vertice, Peso>> preparado);
+		void preparaAreaBmssp(int nivelInicial);
+		// true quando h alvos e todos esto abaixo de limite, ou seja, j tm distncia final
+		bool alvosResolvidos(Peso limite) const {
+			if (alvosConsulta.empty()) return false;
+			for (Vertice alvo : alvosConsulta)
+				if (!(distD[alvo] < limite)) return false;
+			return true;
+		}
 
 	private:
-		const Grafo *ptrGrafo;
-		std::vector<double> distD;
+		// Estado compartilhado: nunca  alterado depois de montado, setGrafo e preprocessaLandmarks trocam o ponteiro
+		std::shared_ptr<const GrafoPreparado<Vertice, Peso>> grafoCompartilhado;
+		std::shared_ptr<const TabelaLandmarks<Vertice, Peso>> tabelaLandmarks; // nula at preprocessaLandmarks/carregaLandmarks
+
+		// Cpias dos campos de grafoCompartilhado mais lidos, para os laos no passarem pelo ponteiro
+		VisaoCSR<Vertice, Peso> visaoGrafo;
+		VisaoCSR<Vertice, Peso> visaoReversa; // vazia at exigeReverso
+		std::span<const Vertice> paraInterno;
+		std::span<const Vertice> paraOriginal;
 		size_t maxContagemK, passosT, tamGrafo;
 		double logN;
+
+		// Estado de cada busca
+		std::vector<Vertice> predecessores;
+		std::vector<Vertice> alvosConsulta; // ids internos, ordenados; vazio = rvore completa
+		FilaDijkstra filaDijkstra = FilaDijkstra::DAria;
+		HeapIndexado<Vertice, Peso> heapIndexado; // usado pelo dijkstra e pelo baseCase; posies alocadas em setGrafo
+		HeapIndexado<Vertice, Peso> heapIndexadoReverso; // lado do alvo no Dijkstra bidirecional
+		std::vector<Peso> distD;
+
+		// Memria de trabalho do Dijkstra bidirecional, alocada na primeira consulta depois de setGrafo. Entre as consultas
+		// fica em INFINITO / NULO / false: cada uma limpa s os vrtices que a busca reversa e o caminho tocaram
+		struct AreaBidirecional {
+			std::vector<Peso> distReversa; // distncia at o alvo
+			std::vector<Vertice> sucessores; // rvore da busca reversa: prximo vrtice a caminho do alvo
+			std::vector<Vertice> tocadosReversa; // vrtices com distReversa finita
+			std::vector<char> noCaminho; // vrtices do trecho origem -> encontro
+			std::vector<Vertice> caminho; // o prprio trecho, para limpar noCaminho; tambm  o buffer de ajustaRepresentantes
+		} areaBidirecional;
+		// Potencial de cada vrtice na consulta A* atual, calculado quando ele  alcanado pela primeira vez. S vale onde
+		// distD  finito, ento no precisa ser limpo entre as consultas
+		std::vector<Peso> potencialAEstrela;
+
+		// Memria de trabalho do BMSSP, alocada na primeira execBmssp depois de setGrafo. Cada uso devolve os vetores ao
+		// estado inicial (NULO / false) limpando s as posies que tocou, ento nenhuma chamada recursiva paga O(n)
+		struct AreaBmssp {
+			std::vector<Vertice> florestaF;
+			std::vector<Vertice> camada;
+			std::vector<char> alcancadosW;
+			// v j entrou na camada atual do findPivots se camadaMarcada[v] == geracaoCamada. Comear uma camada nova  s
+			// incrementar a gerao; o vetor s  zerado quando o contador d a volta
+			std::vector<uint32_t> camadaMarcada;
+			uint32_t geracaoCamada = 0;
+			bool limpaCamadas = false; // MarcacaoCamadas::Limpeza: zera o vetor em toda camada e usa sempre a gerao 1
+			void proximaCamada() {
+				if (++geracaoCamada == 0 || limpaCamadas) {
+					std::fill(camadaMarcada.begin(), camadaMarcada.end(), 0);
+					geracaoCamada = 1;
+				}
+			}
+			// F restrita a W em CSR e o tamanho de cada rvore, indexados pela posio em W (escolhePivots)
+			std::vector<Vertice> indiceW;
+			std::vector<size_t> iniciosF;
+			std::vector<Vertice> filhosF;
+			std::vector<Vertice> ordemF;
+			std::vector<size_t> tamanhoF;
+			// S h uma chamada ativa por nvel, ento o que precisa sobreviver  chamada de baixo fica num buffer do nvel,
+			// reaproveitado entre chamadas e consultas: a recurso aloca por nvel e no por chamada
+			struct NivelBmssp {
+				std::vector<Vertice> alcancadosW; // W, lido de novo depois do lao de pulls
+				std::vector<Vertice> fronteiraLote; // S_i puxado de D, que o nvel de baixo recebe como span
+				std::vector<Vertice> resolvidosLote; // U_i, acrescentado pelo nvel de baixo
+				// quem j est no U deste nvel. So n bytes por nvel, alocados no primeiro findPivots dele; o nvel 0
+				// (baseCase) nunca aloca, ento com l nveis a recurso guarda (l - 1) * n bytes de marcas
+				std::vector<char> resolvidos;
+			};
+			std::vector<NivelBmssp> niveis;
+			std::vector<char> completosBase; // grupo empatado que o baseCase fecha de uma vez; alocado no primeiro empate
+			std::vector<Vertice> origensRaiz; // S da chamada inicial
+			// de iniciaPilhaBmssp at a chamada da raiz terminar. Se a prxima busca comea com isso ainda true, a anterior
+			// foi abandonada e preparaAreaBmssp zera os resolvidos de todos os nveis
+			bool buscaEmCurso = false;
+			std::vector<Vertice> resolvidosRaiz; // U da chamada inicial, que ningum l
+			// usados s entre uma chamada de baixo e a prxima
+			std::vector<Vertice> pivotsP;
+			std::vector<Vertice> fronteiraAnterior;
+			std::vector<Vertice> proximaFronteira;
+			std::vector<std::pair<Peso, Vertice>> paresPull;
+			std::vector<std::pair<Peso, Vertice>> loteK;
+		} areaBmssp;
+
+		// Chamadas do BMSSP em andamento. Como s h uma ativa por nvel, o quadro do nvel n  o da chamada de nvel n e a
+		// pilha vai de nivelRaiz at nivelAtivo: nunca passa de ceil(log n / t) + 1 quadros, seja qual for o grafo.
+		// Quem chama fica na etapa Retorno at o quadro de baixo terminar e deixar o B' dele em retornoFilho
+		enum class EtapaBmssp { Pivots, Pull, Retorno };
+		struct QuadroBmssp {
+			EtapaBmssp etapa = EtapaBmssp::Pivots;
+			bool pivotsIniciados = false; // o findPivots desta chamada j comeou (e parou no meio de uma rodada)
+			size_t rodadaPivots = 0, proximoPivot = 0; // rodada do findPivots e prximo vrtice da camada anterior a relaxar
+			Peso limiteB = 0; // B desta chamada
+			Peso limiteLote = 0; // B_i do ltimo pull
+			size_t proximoResolvido = 0; // prximo vrtice de U_i a relaxar na etapa Retorno
+			Peso Bfinal = 0;
+			size_t inicioU = 0; // onde U desta chamada comea no vetor de quem chamou
+			size_t limiteU = 0; // k * 2^(nivel * t): com U desse tamanho a chamada para
+			std::optional<D<Vertice, Peso>> estruturaD; // construdo na primeira chamada do nvel e reiniciado nas seguintes
+		};
+		struct PilhaBmssp {
+			std::vector<QuadroBmssp> quadros;
+			int nivelRaiz = -1;
+			int nivelAtivo = -1; // negativo: nenhuma busca em andamento
+			Peso retornoFilho = 0;
+			void descarta() {
+				for (QuadroBmssp& quadro : quadros) quadro.estruturaD.reset();
+				nivelAtivo = -1;
+			}
+			// D guarda iteradores para as prprias listas, ento a cpia de um Algoritmo no leva a busca pausada
+			PilhaBmssp() = default;
+			PilhaBmssp(const PilhaBmssp&) {}
+			PilhaBmssp& operator=(const PilhaBmssp&) { descarta(); return *this; }
+		} pilhaBmssp;
 	};
 }
-
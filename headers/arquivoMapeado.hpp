@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace CaminhoMinimo {
+	// Mapeia um arquivo inteiro na memória somente para leitura (mmap no Linux, MapViewOfFile no Windows).
+	// O conteúdo é carregado sob demanda pelo sistema operacional, então abrir um arquivo de vários GB é imediato.
+	class ArquivoMapeado {
+	public:
+		ArquivoMapeado() = default;
+		explicit ArquivoMapeado(const std::string& caminho); // lança std::runtime_error se não conseguir mapear
+		~ArquivoMapeado();
+
+		ArquivoMapeado(const ArquivoMapeado&) = delete;
+		ArquivoMapeado& operator=(const ArquivoMapeado&) = delete;
+		ArquivoMapeado(ArquivoMapeado&& outro) noexcept;
+		ArquivoMapeado& operator=(ArquivoMapeado&& outro) noexcept;
+
+		const char* dados() const { return ptrDados; }
+		size_t tamanho() const { return tamDados; }
+
+	private:
+		void fecha();
+		void tomaDe(ArquivoMapeado& outro);
+
+	private:
+		const char* ptrDados = nullptr;
+		size_t tamDados = 0;
+#ifdef _WIN32
+		void* handleArquivo = nullptr;
+		void* handleMapeamento = nullptr;
+#else
+		int descritor = -1;
+#endif
+	};
+}
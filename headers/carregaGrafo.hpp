@@ -0,0 +1,34 @@
+#pragma once
+
+#include "algoritmo.hpp"
+
+#include <string>
+#include <vector>
+
+// Leitura de grafos externos (DIMACS .gr e listas de arestas) direto para GrafoCSR.
+// O arquivo é mapeado em memória, dividido em pedaços por linha e cada thread interpreta o seu pedaço;
+// depois o CSR é montado com uma ordenação por contagem paralela (constroiCSR).
+namespace CaminhoMinimo {
+	template <typename Vertice = size_t, typename Peso = double>
+	struct Aresta {
+		Vertice origem;
+		Vertice destino;
+		Peso peso;
+	};
+
+	// Monta o CSR a partir de listas de arestas (normalmente uma lista por thread produtora).
+	// A ordem relativa das arestas de um mesmo vértice é preservada: primeiro pela lista, depois pela posição nela.
+	// numThreads = 0 usa std::thread::hardware_concurrency().
+	template <typename Vertice, typename Peso>
+	GrafoCSR<Vertice, Peso> constroiCSR(size_t numVertices, std::vector<std::vector<Aresta<Vertice, Peso>>>& listasArestas, size_t numThreads = 0);
+
+	// Formato DIMACS do 9th Implementation Challenge: linhas "c ..." (comentário), "p sp <n> <m>" e "a <u> <v> <peso>", vértices a partir de 1.
+	template <typename Vertice = size_t, typename Peso = double>
+	GrafoCSR<Vertice, Peso> leDimacs(const std::string& caminho, size_t numThreads = 0);
+
+	// Uma aresta por linha: "<origem> <destino> [peso]", separados por espaços ou tabs, vértices a partir de 0.
+	// Sem peso a aresta vale 1. Linhas vazias ou começando com '#' ou '%' são ignoradas. n = maior id + 1.
+	// Arquivo vazio ou sem nenhuma aresta lança std::runtime_error (como DIMACS sem a linha "p" ou com n = 0).
+	template <typename Vertice = size_t, typename Peso = double>
+	GrafoCSR<Vertice, Peso> leListaArestas(const std::string& caminho, size_t numThreads = 0);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "algoritmo.hpp"
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Corpus de grafos de teste em disco, só com acréscimos (substitui o JSON reescrito inteiro por salvaGrafo).
+//   <caminho>      registros concatenados: [cabeçalho][id][grafo binário (grafoBinario.hpp)][distâncias][predecessores]
+//   <caminho>.idx  um EntradaIndiceCorpus de tamanho fixo por registro, na ordem em que foram acrescentados
+// Acrescentar um grafo custa O(tamanho dele) e ler um grafo pelo id só toca o registro dele.
+// O índice é gravado depois do registro, então um registro sem entrada no índice (ex: queda no meio da escrita) é ignorado.
+// Uma entrada pela metade no fim do índice é cortada ao abrir, antes de qualquer acréscimo.
+namespace CaminhoMinimo {
+	constexpr uint32_t VERSAO_CORPUS = 1;
+	constexpr size_t TAMANHO_MAX_ID_CORPUS = 47;
+
+	struct CabecalhoRegistroCorpus {
+		char magica[8]; // "BMSSPRG"
+		uint32_t versao;
+		uint32_t tamanhoId;
+		uint64_t tamanho;   // número de vértices
+		double densidade;
+		// posições em bytes relativas ao início do registro
+		uint64_t offsetGrafo;
+		uint64_t tamanhoGrafo;
+		uint64_t tamanhoSolucao; // entradas em distâncias e em predecessores (0 se não houver gabarito)
+		uint64_t offsetDistancias;
+		uint64_t offsetPredecessores;
+		uint64_t tamanhoTotal;
+	};
+
+	struct EntradaIndiceCorpus {
+		char id[TAMANHO_MAX_ID_CORPUS + 1]; // terminado em '\0'
+		uint64_t offset;  // início do registro no arquivo de dados
+		uint64_t tamanho; // bytes do registro
+	};
+	static_assert(sizeof(EntradaIndiceCorpus) == 64, "a entrada do indice faz parte do formato em disco");
+
+	// Um grafo do corpus com a solução de Bellman-Ford (origem 0) usada como gabarito.
+	struct InstanciaCorpus {
+		std::string id;
+		size_t tamanho = 0;
+		double densidade = 0.0;
+		GrafoCSR<size_t, double> grafo;
+		std::vector<double> distancias;
+		std::vector<size_t> predecessores;
+	};
+
+	class CorpusGrafos {
+	public:
+		// Abre (ou cria) o corpus em 'caminho'. Só o índice é lido para a memória; se só o arquivo de dados
+		// existir, o índice é reconstruído percorrendo os registros.
+		explicit CorpusGrafos(const std::string& caminho);
+
+		// Acrescenta o grafo, calcula o gabarito com bellmanFord e devolve o id gerado ("Grafo_N<n>D<dens>_<k>").
+		std::string acrescenta(size_t tamanho, double densidade, const Grafo& grafo);
+		void acrescenta(const std::string& id, size_t tamanho, double densidade, const Grafo& grafo,
+			const std::vector<double>& distancias, const std::vector<size_t>& predecessores);
+
+		bool contem(const std::string& id) const { return posicaoPorId.count(id) != 0; }
+		InstanciaCorpus le(const std::string& id) const; // lança std::out_of_range se o id não existir
+		InstanciaCorpus le(size_t posicao) const;        // posição na ordem de inserção
+
+		size_t quantidade() const { return indice.size(); }
+		const std::vector<EntradaIndiceCorpus>& entradas() const { return indice; }
+
+	private:
+		void reconstroiIndice(std::istream& dados);
+		void gravaIndice();
+
+		std::string caminhoDados;
+		std::string caminhoIndice;
+		std::vector<EntradaIndiceCorpus> indice;
+		std::unordered_map<std::string, size_t> posicaoPorId;
+	};
+}
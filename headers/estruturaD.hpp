@@ -8,41 +8,55 @@
 #include <unordered_map>
 #include <utility> // Para std::pair
 #include <limits>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
 
-using ParDistVertice = std::pair<double, size_t>; // (distancia, vertice)
-using Bloco = std::list<ParDistVertice>; 
-
-#ifdef O1
-struct Status {
-	double distancia;
-	std::list<ParDistVertice>::iterator iElem;
-	std::list<Bloco>::iterator iBloco;
-	bool pertenceD1;
-};
-#endif
-
+template <typename Vertice = size_t, typename Peso = double>
 class D {
 public:
-	D(size_t M, double B); // Initialize(M,B)
+	using ParDistVertice = std::pair<Peso, Vertice>; // (distancia, vertice)
+	using Bloco = std::list<ParDistVertice>;
 
-	void insert(size_t vertice, double distancia);
+	D(size_t M, Peso B); // Initialize(M,B)
+	void reinicia(size_t M, Peso B); // Initialize(M,B) no mesmo objeto, guardando a capacidade do status e de menores
+
+	void insert(Vertice vertice, Peso distancia);
 	void batchPrepend(std::vector<ParDistVertice> &loteL);
-	std::pair<double, std::vector<ParDistVertice>> pull();
+	Peso pull(std::vector<ParDistVertice> &loteSi); // devolve B_i e coloca S_i em loteSi
+	Peso menorChave() const; // O(log) amortizado
 
 private:
-	void removeChave(size_t vertice);
-	void dividir(std::map<double, std::list<Bloco>::iterator>::iterator &iLimites);
+#ifdef O1
+	struct Status {
+		Peso distancia;
+		typename Bloco::iterator iElem;
+		typename std::list<Bloco>::iterator iBloco;
+		bool pertenceD1;
+	};
+#endif
+	using MapaLimites = std::map<Peso, typename std::list<Bloco>::iterator>;
+
+	void removeChave(Vertice vertice);
+	void registraChave(Vertice vertice, Peso distancia) {
+		menores.push_back({ distancia, vertice });
+		std::push_heap(menores.begin(), menores.end(), std::greater<ParDistVertice>());
+	}
+	void dividir(typename MapaLimites::iterator &iLimites);
 	void dividirLote(std::vector<ParDistVertice>& lotes, size_t inicio, size_t fim);
 private:
 	size_t tamLoteM;
-	double limiteSuperiorB;
+	Peso limiteSuperiorB;
 	std::list<Bloco> blocosD_0;
 	std::list<Bloco> blocosD_1;
 
-	std::map<double, std::list<Bloco>::iterator> limites;
+	MapaLimites limites;
 #ifdef O1
-	std::unordered_map<size_t, Status> status;
+	std::unordered_map<Vertice, Status> status;
 #else
-	std::unordered_map<size_t, double> status;
+	std::unordered_map<Vertice, Peso> status;
 #endif
-};
\ No newline at end of file
+	// Heap de mínimo com toda chave inserida, com remoção preguiçosa: o topo só vale se status ainda tiver o vértice com
+	// essa distância. Vetor em vez de priority_queue para reinicia poder limpar sem soltar a memória
+	mutable std::vector<ParDistVertice> menores;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Fila de baldes circulares (Dial) para o Dijkstra quando os pesos estão numa faixa [pesoMin, pesoMax] conhecida.
+// O balde k guarda as distâncias em [k * largura, (k + 1) * largura). Com largura <= pesoMin, relaxar um vértice do
+// balde atual sempre cai num balde posterior, então a ordem dentro do balde não importa e o resultado é exato
+// mesmo com pesos não inteiros. Só floor(pesoMax / largura) + 2 baldes ficam ocupados ao mesmo tempo, então eles
+// são reaproveitados em anel; o custo total é O(m + n * pesoMax / largura).
+// A interface (push/top/pop/empty) é a mesma de FilaPrioridade para os dois serem trocados no Dijkstra.
+namespace CaminhoMinimo {
+	template <typename Vertice, typename Peso>
+	class FilaDial {
+	public:
+		// inicio é a menor chave que será inserida; as chaves iniciais precisam caber em [inicio, inicio + pesoMax]
+		FilaDial(Peso largura, Peso pesoMax, Peso inicio = 0)
+			: largura(largura), baldes(static_cast<size_t>(std::floor(pesoMax / largura)) + 2), baldeAtual(static_cast<size_t>(inicio / largura)) {}
+
+		bool empty() const { return tamanho == 0; }
+
+		void push(const std::pair<Peso, Vertice>& par) {
+			size_t absoluto = static_cast<size_t>(par.first / largura);
+			// chave atrás do balde atual ou além do anel: algum peso está fora da faixa passada no construtor
+			if (absoluto < baldeAtual || absoluto - baldeAtual >= baldes.size())
+				throw std::out_of_range("FilaDial: peso fora da faixa configurada");
+			baldes[absoluto % baldes.size()].push_back(par);
+			tamanho++;
+		}
+
+		std::pair<Peso, Vertice> top() {
+			avancaBalde();
+			return baldes[baldeAtual % baldes.size()].back();
+		}
+
+		void pop() {
+			avancaBalde();
+			baldes[baldeAtual % baldes.size()].pop_back();
+			tamanho--;
+		}
+
+	private:
+		void avancaBalde() {
+			while (baldes[baldeAtual % baldes.size()].empty()) baldeAtual++;
+		}
+
+		Peso largura;
+		std::vector<std::vector<std::pair<Peso, Vertice>>> baldes;
+		size_t baldeAtual; // índice absoluto (sem o módulo) do menor balde que pode ter elementos
+		size_t tamanho = 0;
+	};
+}
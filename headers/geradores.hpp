@@ -0,0 +1,27 @@
+#pragma once
+
+#include "algoritmo.hpp"
+
+#include <cstddef>
+
+// Geradores de grafos grandes e esparsos, direto em CSR. Diferente de geraGrafo (helpers.hpp), cujo
+// número de arestas é densidade * n * (n - 1), aqui o tamanho é controlado pelo grau médio, o que permite
+// chegar a 10^6 - 10^8 vértices. Os pesos são sorteados em [1, PESOMAX) como em geraGrafo.
+// numThreads = 0 usa todos os núcleos; cada thread tem o seu próprio motor aleatório.
+namespace CaminhoMinimo {
+	// Erdős–Rényi G(n, p) com p = grauMedio / (n - 1), sem laços nem arestas repetidas.
+	template <typename Vertice = size_t, typename Peso = double>
+	GrafoCSR<Vertice, Peso> geraGrafoEsparso(size_t tamanho, double grauMedio, size_t numThreads = 0);
+
+	// Grade 2D linhas x colunas com arestas nos dois sentidos entre vizinhos (4-vizinhança), parecida com malha viária.
+	// O vértice (i, j) tem id i * colunas + j.
+	template <typename Vertice = size_t, typename Peso = double>
+	GrafoCSR<Vertice, Peso> geraGrafoGrade(size_t linhas, size_t colunas, size_t numThreads = 0);
+
+	// R-MAT (lei de potência) com 2^escala vértices e grauMedio * 2^escala arestas sorteadas.
+	// Os padrões (a, b, c) são os do Graph500; d = 1 - a - b - c. Laços são descartados, arestas
+	// repetidas são mantidas, e os ids são embaralhados para não dar localidade artificial aos vértices de grau alto.
+	template <typename Vertice = size_t, typename Peso = double>
+	GrafoCSR<Vertice, Peso> geraGrafoRMAT(size_t escala, double grauMedio, size_t numThreads = 0,
+		double a = 0.57, double b = 0.19, double c = 0.19);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "algoritmo.hpp"
+#include "arquivoMapeado.hpp"
+
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+// Formato binário versionado para grafos em CSR. O arquivo é a imagem dos vetores de GrafoCSR (exata onde size_t tem 64 bits):
+//   [cabeçalho][inicios (uint64)][destinos (Vertice)][pesos (Peso)]
+// com cada seção alinhada em ALINHAMENTO_GRAFO_BINARIO bytes, então depois de mapeado basta apontar
+// uma VisaoCSR para dentro do arquivo, sem nenhuma etapa de desserialização.
+namespace CaminhoMinimo {
+	constexpr uint32_t VERSAO_GRAFO_BINARIO = 1;
+	constexpr uint32_t MARCA_ENDIAN = 0x01020304; // lida ao contrário se o arquivo veio de uma máquina com outra ordem de bytes
+	constexpr uint64_t ALINHAMENTO_GRAFO_BINARIO = 64;
+
+	struct CabecalhoGrafoBinario {
+		char magica[8]; // "BMSSPGR"
+		uint32_t versao;
+		uint32_t marcaEndian;
+		uint32_t bytesVertice; // sizeof(Vertice) usado ao salvar
+		uint32_t bytesPeso;    // sizeof(Peso) usado ao salvar
+		uint64_t numVertices;
+		uint64_t numArestas;
+		// posições em bytes relativas ao início do cabeçalho
+		uint64_t offsetInicios;
+		uint64_t offsetDestinos;
+		uint64_t offsetPesos;
+		uint64_t tamanhoTotal;
+	};
+	static_assert(sizeof(CabecalhoGrafoBinario) == 72, "o cabecalho faz parte do formato em disco");
+
+	// Arredonda 'posicao' para o próximo múltiplo de ALINHAMENTO_GRAFO_BINARIO (também usado pelo corpus)
+	inline uint64_t alinha(uint64_t posicao)
+	{
+		return (posicao + ALINHAMENTO_GRAFO_BINARIO - 1) / ALINHAMENTO_GRAFO_BINARIO * ALINHAMENTO_GRAFO_BINARIO;
+	}
+
+	// Escreve o preenchimento entre uma seção e o próximo alinhamento; 'quantidade' < ALINHAMENTO_GRAFO_BINARIO
+	inline void completaComZeros(std::ostream& saida, uint64_t quantidade)
+	{
+		static const char zeros[ALINHAMENTO_GRAFO_BINARIO] = {};
+		saida.write(zeros, static_cast<std::streamsize>(quantidade));
+	}
+
+	// Escreve valores size_t como uint64, a largura usada em disco para inicios e predecessores em qualquer plataforma
+	inline void escreveComoUint64(std::ostream& saida, std::span<const size_t> valores)
+	{
+		if constexpr (sizeof(size_t) == sizeof(uint64_t)) {
+			saida.write(reinterpret_cast<const char*>(valores.data()), static_cast<std::streamsize>(valores.size_bytes()));
+		} else {
+			uint64_t bloco[512];
+			for (size_t i = 0; i < valores.size(); i += 512) {
+				size_t quantidade = std::min<size_t>(512, valores.size() - i);
+				for (size_t j = 0; j < quantidade; j++)
+					bloco[j] = valores[i + j];
+				saida.write(reinterpret_cast<const char*>(bloco), static_cast<std::streamsize>(quantidade * sizeof(uint64_t)));
+			}
+		}
+	}
+
+	// Tamanho em bytes (já com o alinhamento final) que escreveGrafoBinario vai ocupar.
+	template <typename Vertice, typename Peso>
+	uint64_t tamanhoGrafoBinario(const VisaoCSR<Vertice, Peso>& grafo);
+
+	// Escreve a imagem do grafo na posição atual do stream e devolve quantos bytes foram escritos.
+	// Os offsets são relativos ao início da imagem, então ela pode ser embutida em outros arquivos (ex: corpus).
+	template <typename Vertice, typename Peso>
+	uint64_t escreveGrafoBinario(std::ostream& saida, const VisaoCSR<Vertice, Peso>& grafo);
+
+	// Valida o cabeçalho e devolve uma visão que aponta diretamente para 'dados'. Lança std::runtime_error
+	// se a imagem estiver truncada, for de outra versão, usar larguras de tipo diferentes de <Vertice, Peso>
+	// ou tiver seções desalinhadas, inicios fora de ordem ou destinos >= n.
+	// Onde size_t tem 32 bits os inicios (uint64 no arquivo) são convertidos para 'iniciosConvertidos', que
+	// precisa viver tanto quanto a visão; em 64 bits o vetor fica vazio e a visão aponta para o próprio arquivo.
+	template <typename Vertice, typename Peso>
+	VisaoCSR<Vertice, Peso> interpretaGrafoBinario(const char* dados, size_t tamanho, std::vector<size_t>& iniciosConvertidos);
+
+	template <typename Vertice, typename Peso>
+	void salvaGrafoBinario(const VisaoCSR<Vertice, Peso>& grafo, const std::string& caminho);
+
+	template <typename Vertice, typename Peso>
+	void salvaGrafoBinario(const GrafoCSR<Vertice, Peso>& grafo, const std::string& caminho) { salvaGrafoBinario(grafo.visao(), caminho); }
+
+	// Grafo lido de um arquivo binário mapeado em memória. Abrir custa o mmap mais uma leitura de inicios e
+	// destinos para validá-los; os pesos só são carregados conforme os algoritmos percorrem as arestas.
+	// O objeto precisa viver enquanto algum Algoritmo estiver usando a visão.
+	template <typename Vertice = size_t, typename Peso = double>
+	class GrafoMapeado {
+	public:
+		explicit GrafoMapeado(const std::string& caminho)
+			: arquivo(caminho), visaoGrafo(interpretaGrafoBinario<Vertice, Peso>(arquivo.dados(), arquivo.tamanho(), iniciosConvertidos)) {}
+
+		const VisaoCSR<Vertice, Peso>& visao() const { return visaoGrafo; }
+		size_t tamanho() const { return visaoGrafo.tamanho(); }
+		size_t numArestas() const { return visaoGrafo.numArestas(); }
+
+	private:
+		ArquivoMapeado arquivo;
+		std::vector<size_t> iniciosConvertidos; // só usado onde size_t tem 32 bits
+		VisaoCSR<Vertice, Peso> visaoGrafo;
+	};
+}
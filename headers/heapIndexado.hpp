@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#ifndef ARIDADEHEAP
+#define ARIDADEHEAP 4 // filhos por nó do heap indexado
+#endif
+
+// Heap d-ário indexado por vértice: cada vértice aparece no máximo uma vez e a posição dele no heap fica
+// em posicao[v], o que permite diminuir a chave no lugar em vez de empilhar cópias como FilaPrioridade.
+// O heap nunca passa de n itens. posicao é alocado uma vez (redimensiona) e volta a AUSENTE quando o
+// vértice sai, então o mesmo heap serve para várias buscas sem limpar O(n).
+// push tem a semântica de FilaPrioridade com remoção preguiçosa (fica a menor chave de cada vértice),
+// então os dois podem ser trocados no Dijkstra.
+namespace CaminhoMinimo {
+	template <typename Vertice, typename Peso, size_t Aridade = ARIDADEHEAP>
+	class HeapIndexado {
+		static_assert(Aridade >= 2, "o heap precisa de pelo menos 2 filhos por no");
+	public:
+		static constexpr Vertice AUSENTE = std::numeric_limits<Vertice>::max();
+
+		void redimensiona(size_t tamanho) {
+			itens.clear();
+			posicao.assign(tamanho, AUSENTE);
+		}
+
+		bool empty() const { return itens.empty(); }
+		size_t size() const { return itens.size(); }
+		bool contem(Vertice vertice) const { return posicao[vertice] != AUSENTE; }
+
+		// insere o vértice ou diminui a chave dele; chaves maiores que a atual são ignoradas
+		void push(const std::pair<Peso, Vertice>& par) {
+			size_t i = posicao[par.second];
+			if (i == AUSENTE) {
+				i = itens.size();
+				itens.push_back(par);
+			}
+			else if (par < itens[i]) itens[i] = par;
+			else return;
+			sobe(i);
+		}
+
+		const std::pair<Peso, Vertice>& top() const { return itens[0]; }
+
+		void pop() {
+			posicao[itens[0].second] = AUSENTE;
+			if (itens.size() > 1) {
+				itens[0] = itens.back();
+				itens.pop_back();
+				desce(0);
+			}
+			else itens.pop_back();
+		}
+
+		// esvazia em O(itens restantes)
+		void clear() {
+			for (const auto& item : itens) posicao[item.second] = AUSENTE;
+			itens.clear();
+		}
+
+	private:
+		void sobe(size_t i) {
+			auto item = itens[i];
+			while (i > 0) {
+				size_t pai = (i - 1) / Aridade;
+				if (!(item < itens[pai])) break;
+				itens[i] = itens[pai];
+				posicao[itens[i].second] = static_cast<Vertice>(i);
+				i = pai;
+			}
+			itens[i] = item;
+			posicao[item.second] = static_cast<Vertice>(i);
+		}
+
+		void desce(size_t i) {
+			auto item = itens[i];
+			size_t tamanho = itens.size();
+			while (true) {
+				size_t primeiroFilho = i * Aridade + 1;
+				if (primeiroFilho >= tamanho) break;
+				size_t ultimoFilho = std::min(primeiroFilho + Aridade, tamanho);
+
+				size_t menor = primeiroFilho;
+				for (size_t filho = primeiroFilho + 1; filho < ultimoFilho; filho++)
+					if (itens[filho] < itens[menor]) menor = filho;
+				if (!(itens[menor] < item)) break;
+
+				itens[i] = itens[menor];
+				posicao[itens[i].second] = static_cast<Vertice>(i);
+				i = menor;
+			}
+			itens[i] = item;
+			posicao[item.second] = static_cast<Vertice>(i);
+		}
+
+		std::vector<std::pair<Peso, Vertice>> itens;
+		std::vector<Vertice> posicao;
+	};
+}
@@ -1,13 +1,23 @@
 #pragma once
 
 #include "algoritmo.hpp"
+#include "corpus.hpp"
 
 #include <string>
+#include <functional>
 
 std::pair<std::vector<double>, std::vector<size_t>> bellmanFord(const CaminhoMinimo::Grafo& grafo);
 
-CaminhoMinimo::Grafo geraGrafo(size_t tamanho, double densidade);
+// numThreads = 0 usa todos os núcleos; o grafo gerado segue a mesma distribuição para qualquer número de threads
+CaminhoMinimo::Grafo geraGrafo(size_t tamanho, double densidade, size_t numThreads = 1);
 
+// Formato JSON legado: reescreve o arquivo inteiro a cada chamada (O(N^2) para N grafos).
+// Para montar corpora grandes use CaminhoMinimo::CorpusGrafos (corpus.hpp), que só acrescenta.
 void salvaGrafo(size_t tamanho, double densidade, const CaminhoMinimo::Grafo& grafo, std::string path);
 
-void imprimeArquivo(const std::string& caminhoArquivo);
\ No newline at end of file
+void imprimeArquivo(const std::string& caminhoArquivo);
+
+// Lê um arquivo no formato de salvaGrafo de forma incremental (SAX), entregando um grafo por vez em 'aoLerGrafo'.
+// Só o grafo atual fica em memória. Se 'aoLerGrafo' retornar false a leitura para ali.
+// Retorna false se o arquivo não puder ser aberto ou não for um JSON válido.
+bool percorreGrafosJSON(const std::string& caminhoArquivo, const std::function<bool(const CaminhoMinimo::InstanciaCorpus&)>& aoLerGrafo);
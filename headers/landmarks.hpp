@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Tabelas do ALT (A*, landmarks e desigualdade triangular; Goldberg e Harrelson). Para cada vértice v e landmark L
+// guardamos d(L, v) e d(v, L); pela desigualdade triangular d(v, alvo) >= d(v, L) - d(alvo, L) e >= d(L, alvo) - d(L, v),
+// e o maior desses limites é o potencial usado pelo A*. As tabelas ficam vértice a vértice (v * numLandmarks + i),
+// então o potencial de v é lido de uma linha de cache contígua.
+namespace CaminhoMinimo {
+	constexpr uint32_t VERSAO_LANDMARKS = 2;
+
+	struct CabecalhoLandmarks {
+		char magica[8]; // "BMSSPLM"
+		uint32_t versao;
+		uint32_t marcaEndian;
+		uint32_t bytesVertice;
+		uint32_t bytesPeso;
+		uint64_t numVertices; // numVertices, numArestas, as opções e impressaoGrafo conferem se a tabela é do grafo carregado
+		uint64_t numArestas;
+		uint64_t numLandmarks;
+		uint32_t grauConstante; // OpcoesPreprocessamento do setGrafo (grauMaximo = 0 sem grauConstante)
+		uint32_t ordenacao;
+		uint64_t grauMaximo;
+		uint64_t impressaoGrafo; // hash de inicios, destinos e pesos do grafo preparado (ids internos)
+		// seguem landmarks (Vertice), distDe (Peso) e distPara (Peso), sem preenchimento
+	};
+	static_assert(sizeof(CabecalhoLandmarks) == 72, "o cabecalho faz parte do formato em disco");
+
+	template <typename Vertice, typename Peso>
+	struct TabelaLandmarks {
+		std::vector<Vertice> landmarks;
+		std::vector<Peso> distDe;   // distDe[v * k + i] = d(landmarks[i], v)
+		std::vector<Peso> distPara; // distPara[v * k + i] = d(v, landmarks[i])
+		size_t numVertices = 0, numArestas = 0;
+
+		size_t numLandmarks() const { return landmarks.size(); }
+		bool vazia() const { return landmarks.empty(); }
+
+		// Limite inferior de d(v, alvo). Infinito quando alguma landmark prova que v não chega no alvo.
+		// Sem desvios, para o compilador vetorizar: com paraAlvo finito e paraV infinito a diferença é +inf e o máximo vira
+		// infinito; com paraAlvo infinito ela é -inf ou NaN, e std::max(limite, NaN) devolve limite. Idem para deV e deAlvo
+		Peso potencial(Vertice v, Vertice alvo) const {
+			size_t k = landmarks.size();
+			const Peso* deV = &distDe[static_cast<size_t>(v) * k];
+			const Peso* deAlvo = &distDe[static_cast<size_t>(alvo) * k];
+			const Peso* paraV = &distPara[static_cast<size_t>(v) * k];
+			const Peso* paraAlvo = &distPara[static_cast<size_t>(alvo) * k];
+
+			Peso limite = 0;
+			for (size_t i = 0; i < k; i++) {
+				limite = std::max(limite, paraV[i] - paraAlvo[i]); // d(v, L) <= d(v, alvo) + d(alvo, L)
+				limite = std::max(limite, deAlvo[i] - deV[i]);     // d(L, alvo) <= d(L, v) + d(v, alvo)
+			}
+			return limite;
+		}
+	};
+}
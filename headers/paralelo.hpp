@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace CaminhoMinimo {
+	// 0 significa "uma thread por núcleo"
+	inline size_t resolveThreads(size_t numThreads)
+	{
+		if (numThreads == 0) numThreads = std::thread::hardware_concurrency();
+		return std::max<size_t>(numThreads, 1);
+	}
+
+	// Duas sementes por thread tiradas de 'motor': a thread t monta std::seed_seq{ sementes[2 * t], sementes[2 * t + 1] }
+	// para o seu próprio motor, então o resultado só depende do motor compartilhado e não da ordem das threads
+	template <typename Motor>
+	std::vector<std::seed_seq::result_type> sorteiaSementes(Motor& motor, size_t numThreads)
+	{
+		std::vector<std::seed_seq::result_type> sementes(numThreads * 2);
+		for (auto& valor : sementes) valor = static_cast<std::seed_seq::result_type>(motor());
+		return sementes;
+	}
+
+	// Roda funcao(t) para t em [0, numThreads) e espera todas terminarem. A thread atual faz a parte 0.
+	template <typename Funcao>
+	void paraCadaThread(size_t numThreads, Funcao funcao)
+	{
+		std::vector<std::thread> threads;
+		threads.reserve(numThreads > 0 ? numThreads - 1 : 0);
+		for (size_t t = 1; t < numThreads; t++)
+			threads.emplace_back(funcao, t);
+		funcao(size_t(0));
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	// Roda funcao(t, i) uma vez para cada i em [0, numItens), na thread t, com roubo de trabalho: cada thread começa com
+	// um bloco contíguo de índices e, quando o seu acaba, rouba a metade final do bloco de outra. Serve para itens de
+	// custo desigual (buscas de origens diferentes), em que a divisão fixa deixaria threads paradas esperando a mais lenta.
+	// Cada bloco é um único atômico com [início, fim) em 32 bits cada: o dono avança o início e o ladrão recua o fim, os
+	// dois por compare-exchange. Um bloco só encolhe ou é dividido, então um valor antigo nunca reaparece (sem ABA)
+	template <typename Funcao>
+	void paraCadaIndice(size_t numItens, size_t numThreads, Funcao funcao)
+	{
+		if (numItens > UINT32_MAX)
+			throw std::length_error("paraCadaIndice: mais itens do que cabem em 32 bits");
+		numThreads = std::max<size_t>(std::min(numThreads, numItens), 1);
+
+		struct alignas(64) Bloco { std::atomic<uint64_t> faixa; }; // uma linha de cache por bloco
+		auto junta = [](uint64_t inicio, uint64_t fim) { return inicio | (fim << 32); };
+		std::unique_ptr<Bloco[]> blocos(new Bloco[numThreads]);
+		for (size_t t = 0; t < numThreads; t++)
+			blocos[t].faixa.store(junta(numItens * t / numThreads, numItens * (t + 1) / numThreads), std::memory_order_relaxed);
+
+		paraCadaThread(numThreads, [&](size_t t) {
+			std::atomic<uint64_t>& minha = blocos[t].faixa;
+			while (true) {
+				uint64_t faixa = minha.load(std::memory_order_relaxed);
+				uint64_t inicio = faixa & UINT32_MAX, fim = faixa >> 32;
+				if (inicio < fim) {
+					if (minha.compare_exchange_weak(faixa, junta(inicio + 1, fim), std::memory_order_relaxed))
+						funcao(t, static_cast<size_t>(inicio));
+					continue;
+				}
+
+				// bloco vazio: procura uma vítima a partir da thread seguinte. Só o dono escreve no próprio bloco vazio,
+				// e nenhum ladrão mexe nele porque não há o que roubar
+				bool roubou = false;
+				for (size_t passo = 1; passo < numThreads && !roubou; passo++) {
+					std::atomic<uint64_t>& vitima = blocos[(t + passo) % numThreads].faixa;
+					uint64_t faixaVitima = vitima.load(std::memory_order_relaxed);
+					while (!roubou) {
+						uint64_t inicioVitima = faixaVitima & UINT32_MAX, fimVitima = faixaVitima >> 32;
+						if (inicioVitima >= fimVitima) break;
+						uint64_t corte = fimVitima - (fimVitima - inicioVitima + 1) / 2;
+						if (vitima.compare_exchange_weak(faixaVitima, junta(inicioVitima, corte), std::memory_order_relaxed)) {
+							minha.store(junta(corte, fimVitima), std::memory_order_relaxed);
+							roubou = true;
+						}
+					}
+				}
+				if (!roubou) return; // os índices que estão em trânsito são processados pela thread que os roubou
+			}
+		});
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Radix heap (Ahuja, Mehlhorn, Orlin e Tarjan) para filas monótonas: cada chave inserida precisa ser >= à última
+// chave removida, o que vale no Dijkstra com pesos não negativos. Pesos de ponto flutuante não negativos têm
+// a mesma ordem que os bits deles lidos como inteiro sem sinal, então a chave é o próprio padrão de bits.
+// O balde i guarda as chaves cujo bit mais alto diferente da última removida é o i-ésimo; cada elemento
+// desce de balde no máximo sizeof(Peso) * 8 vezes, o que torna push O(1) e pop O(log C) amortizado.
+// A interface (push/top/pop/empty) é a mesma de FilaPrioridade para os dois serem trocados no Dijkstra.
+namespace CaminhoMinimo {
+	template <typename Vertice, typename Peso>
+	class RadixHeap {
+		static_assert(std::is_floating_point_v<Peso> && (sizeof(Peso) == 4 || sizeof(Peso) == 8), "RadixHeap espera float ou double");
+		using Chave = std::conditional_t<sizeof(Peso) == 4, uint32_t, uint64_t>;
+		static constexpr size_t NUM_BALDES = sizeof(Chave) * 8 + 1;
+
+	public:
+		bool empty() const { return tamanho == 0; }
+
+		void push(const std::pair<Peso, Vertice>& par) {
+			Chave chave = std::bit_cast<Chave>(par.first + Peso(0)); // + 0 transforma -0.0 em 0.0
+			baldes[indiceBalde(chave)].push_back({ chave, par.second });
+			tamanho++;
+		}
+
+		// Menor par. Só é O(1) depois que o balde 0 foi reabastecido, por isso não é const como em priority_queue
+		std::pair<Peso, Vertice> top() {
+			if (baldes[0].empty()) redistribui();
+			return { std::bit_cast<Peso>(baldes[0].back().first), baldes[0].back().second };
+		}
+
+		void pop() {
+			if (baldes[0].empty()) redistribui();
+			baldes[0].pop_back();
+			tamanho--;
+		}
+
+		void clear() {
+			for (auto& balde : baldes) balde.clear();
+			tamanho = 0;
+			ultimaChave = 0;
+		}
+
+	private:
+		size_t indiceBalde(Chave chave) const { return static_cast<size_t>(std::bit_width(chave ^ ultimaChave)); }
+
+		// Acha o primeiro balde não vazio, adota a menor chave dele como ultimaChave e espalha o balde
+		// nos baldes menores; a menor chave sempre cai no balde 0.
+		void redistribui() {
+			size_t i = 1;
+			while (baldes[i].empty()) i++;
+
+			Chave menor = baldes[i][0].first;
+			for (const auto& item : baldes[i])
+				if (item.first < menor) menor = item.first;
+			ultimaChave = menor;
+
+			for (const auto& item : baldes[i])
+				baldes[indiceBalde(item.first)].push_back(item);
+			baldes[i].clear();
+		}
+
+		std::vector<std::pair<Chave, Vertice>> baldes[NUM_BALDES];
+		size_t tamanho = 0;
+		Chave ultimaChave = 0;
+	};
+}
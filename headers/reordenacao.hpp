@@ -0,0 +1,18 @@
+#pragma once
+
+#include "algoritmo.hpp"
+
+#include <vector>
+
+// Renumeração de vértices para melhorar a localidade de distD[vizinho] nas relaxações. A ordem é dada
+// como novoId[v] (id original -> id novo); Algoritmo aplica a permutação em setGrafo quando
+// OpcoesPreprocessamento::ordenacao pede e devolve os resultados nos ids originais.
+namespace CaminhoMinimo {
+	// novoId de cada vértice para a ordenação pedida (Ordenacao::Nenhuma devolve a identidade)
+	template <typename Vertice, typename Peso>
+	std::vector<Vertice> calculaOrdem(const VisaoCSR<Vertice, Peso>& grafo, Ordenacao ordenacao);
+
+	// Cópia do grafo com os vértices renumerados; as listas de vizinhos ficam em ordem crescente de id novo
+	template <typename Vertice, typename Peso>
+	GrafoCSR<Vertice, Peso> permutaGrafo(const VisaoCSR<Vertice, Peso>& grafo, const std::vector<Vertice>& novoId);
+}
@@ -0,0 +1,56 @@
+#include "../headers/algoritmo.hpp"
+
+#include <vector>
+
+namespace CaminhoMinimo {
+    // A* com os potenciais do ALT: a chave de v na fila é distD[v] + potencial(v), um limite inferior do caminho até o
+    // alvo passando por v, então a busca anda na direção do alvo em vez de crescer igual em todas as direções.
+    // Vértices com potencial infinito não chegam no alvo e nem entram na fila. Como o potencial é um limite inferior,
+    // nenhum vértice com chave >= distD[alvo] pode melhorar o alvo, e a busca para quando o topo da fila chega nela. Com
+    // potenciais consistentes isso acontece assim que o alvo sai. Se o arredondamento deixar algum um pouco inconsistente,
+    // um vértice que já saiu volta para a fila quando a distância melhora (o heap indexado reinsere) e o alvo ainda pode
+    // melhorar depois de sair, então parar na primeira saída dele não seria exato.
+    template <typename Vertice, typename Peso>
+    void Algoritmo<Vertice, Peso>::aEstrela(Vertice origem, Vertice alvo) {
+        predecessores.assign(tamGrafo, NULO); // reaproveita a capacidade da busca anterior
+        const TabelaLandmarks<Vertice, Peso>& tabela = *tabelaLandmarks;
+        if (potencialAEstrela.size() != tamGrafo) potencialAEstrela.resize(tamGrafo);
+
+        Peso potencialOrigem = tabela.potencial(origem, alvo);
+        if (!(potencialOrigem < INFINITO)) return;
+        potencialAEstrela[origem] = potencialOrigem;
+        heapIndexado.push({ potencialOrigem, origem });
+
+        while (!heapIndexado.empty() && heapIndexado.top().first < distD[alvo]) {
+            Vertice verticeAtual = heapIndexado.top().second;
+            heapIndexado.pop();
+
+            for (size_t aresta = visaoGrafo.inicios[verticeAtual]; aresta < visaoGrafo.inicios[verticeAtual + 1]; aresta++) {
+                Vertice vizinho = visaoGrafo.destinos[aresta];
+#ifdef LIMPARUIDO
+                Peso distanciaNova = limpaRuido(distD[verticeAtual] + visaoGrafo.pesos[aresta]);
+#else
+                Peso distanciaNova = distD[verticeAtual] + visaoGrafo.pesos[aresta];
+#endif
+                if (distanciaNova < distD[vizinho]) {
+                    // o potencial só depende do vértice, então sai da tabela uma vez por consulta e não a cada melhora
+                    if (!(distD[vizinho] < INFINITO)) {
+                        Peso potencial = tabela.potencial(vizinho, alvo);
+                        if (!(potencial < INFINITO)) continue;
+                        potencialAEstrela[vizinho] = potencial;
+                    }
+
+                    distD[vizinho] = distanciaNova;
+                    predecessores[vizinho] = verticeAtual;
+                    heapIndexado.push({ distanciaNova + potencialAEstrela[vizinho], vizinho });
+                }
+            }
+        }
+        heapIndexado.clear();
+    }
+
+#define INSTANCIA_A_ESTRELA(V, P) \
+    template void Algoritmo<V, P>::aEstrela(V, V);
+
+    CAMINHOMINIMO_TIPOS(INSTANCIA_A_ESTRELA)
+}
@@ -1,47 +1,525 @@
 #include "../headers/algoritmo.hpp"
+#include "../headers/grauConstante.hpp"
+#include "../headers/reordenacao.hpp"
 
 #include <algorithm>
 #include <cmath>
 #include <chrono>
+#include <stdexcept>
 
 namespace CaminhoMinimo {
-	long long Algoritmo::execDijkstra(size_t origem)
+	template <typename Vertice, typename Peso>
+	long long Algoritmo<Vertice, Peso>::execDijkstra(Vertice origem)
 	{
+		return execDijkstra(origem, {});
+	}
+
+	template <typename Vertice, typename Peso>
+	long long Algoritmo<Vertice, Peso>::execBmssp(Vertice origem)
+	{
+		return execBmssp(origem, {});
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::exigeGrafo(const char* funcao) const
+	{
+		if (!grafoCompartilhado)
+			throw std::logic_error(std::string(funcao) + ": chame setGrafo antes");
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::exigeReverso()
+	{
+		const GrafoPreparado<Vertice, Peso>& preparado = *grafoCompartilhado;
+		// outros Algoritmo (threads de execLote, landmarks) podem pedir o mesmo transposto ao mesmo tempo
+		std::call_once(preparado.reversoPronto, [&] { preparado.reverso = transpoeGrafo(preparado.visao); });
+		visaoReversa = preparado.reverso.visao();
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::defineAlvos(const std::vector<Vertice>& alvos)
+	{
+		alvosConsulta.clear();
+		for (Vertice alvo : alvos)
+			alvosConsulta.push_back(paraInterno.empty() ? alvo : paraInterno[alvo]);
+		std::sort(alvosConsulta.begin(), alvosConsulta.end());
+		alvosConsulta.erase(std::unique(alvosConsulta.begin(), alvosConsulta.end()), alvosConsulta.end());
+	}
+
+	template <typename Vertice, typename Peso>
+	std::vector<Vertice> Algoritmo<Vertice, Peso>::inicializaOrigens(const std::vector<Vertice>& origens, const std::vector<Peso>& deslocamentos)
+	{
+		exigeGrafo("execDijkstra/execBmssp");
+		if (!deslocamentos.empty() && deslocamentos.size() != origens.size())
+			throw std::invalid_argument("inicializaOrigens: deslocamentos precisa ter um valor por origem");
+
+		pilhaBmssp.descarta();
 		std::fill(distD.begin(), distD.end(), INFINITO);
-		distD[origem] = 0.0;
+		std::vector<Vertice> internas;
+		internas.reserve(origens.size());
+		for (size_t i = 0; i < origens.size(); i++) {
+			Peso deslocamento = deslocamentos.empty() ? Peso(0) : deslocamentos[i];
+			if (!(deslocamento >= 0 && deslocamento < INFINITO))
+				throw std::invalid_argument("inicializaOrigens: deslocamentos precisam ser finitos e nao negativos");
+
+			Vertice origem = paraInterno.empty() ? origens[i] : paraInterno[origens[i]];
+			if (distD[origem] == INFINITO) internas.push_back(origem);
+			distD[origem] = std::min(distD[origem], deslocamento); // origem repetida fica com o menor deslocamento
+		}
+		return internas;
+	}
+
+	template <typename Vertice, typename Peso>
+	long long Algoritmo<Vertice, Peso>::execDijkstra(Vertice origem, const std::vector<Vertice>& alvos)
+	{
+		defineAlvos(alvos);
+		std::vector<Vertice> origens = inicializaOrigens({ origem }, {});
 
 		auto tempoInicial = std::chrono::high_resolution_clock::now();
-		dijkstra(origem);
+		dijkstra(origens);
 		auto duracao = std::chrono::high_resolution_clock::now() - tempoInicial;
 
 		return std::chrono::duration_cast<std::chrono::microseconds>(duracao).count();
 	}
 
-	long long Algoritmo::execBmssp(size_t origem)
+	template <typename Vertice, typename Peso>
+	long long Algoritmo<Vertice, Peso>::execBmssp(Vertice origem, const std::vector<Vertice>& alvos)
 	{
-		std::fill(distD.begin(), distD.end(), INFINITO);
-		distD[origem] = 0.0;
+		iniciaBmssp(origem, alvos);
+
+		auto tempoInicial = std::chrono::high_resolution_clock::now();
+		continuaBmssp();
+		auto duracao = std::chrono::high_resolution_clock::now() - tempoInicial;
+
+		return std::chrono::duration_cast<std::chrono::microseconds>(duracao).count();
+	}
+
+	template <typename Vertice, typename Peso>
+	long long Algoritmo<Vertice, Peso>::execDijkstra(const std::vector<Vertice>& origens, const std::vector<Peso>& deslocamentos)
+	{
+		alvosConsulta.clear();
+		std::vector<Vertice> internas = inicializaOrigens(origens, deslocamentos);
+
+		auto tempoInicial = std::chrono::high_resolution_clock::now();
+		dijkstra(internas);
+		auto duracao = std::chrono::high_resolution_clock::now() - tempoInicial;
+
+		return std::chrono::duration_cast<std::chrono::microseconds>(duracao).count();
+	}
 
+	// As origens formam a fronteira S da chamada de nível mais alto. Isso respeita a invariante do BMSSP: o caminho
+	// mínimo de qualquer vértice começa na superorigem e passa primeiro por alguma origem cujo deslocamento já é a
+	// distância final dela
+	template <typename Vertice, typename Peso>
+	long long Algoritmo<Vertice, Peso>::execBmssp(const std::vector<Vertice>& origens, const std::vector<Peso>& deslocamentos)
+	{
+		iniciaBmssp(origens, deslocamentos);
+
+		auto tempoInicial = std::chrono::high_resolution_clock::now();
+		continuaBmssp();
+		auto duracao = std::chrono::high_resolution_clock::now() - tempoInicial;
+
+		return std::chrono::duration_cast<std::chrono::microseconds>(duracao).count();
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::iniciaBmssp(Vertice origem, const std::vector<Vertice>& alvos)
+	{
+		defineAlvos(alvos);
+		iniciaPilhaBmssp(inicializaOrigens({ origem }, {}));
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::iniciaBmssp(const std::vector<Vertice>& origens, const std::vector<Peso>& deslocamentos)
+	{
+		alvosConsulta.clear();
+		iniciaPilhaBmssp(inicializaOrigens(origens, deslocamentos));
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::iniciaPilhaBmssp(std::vector<Vertice> origens)
+	{
 		int nivelInicial = static_cast<int>(std::ceil(logN / passosT));
+		predecessores.assign(tamGrafo, NULO);
+		preparaAreaBmssp(nivelInicial);
+
+		areaBmssp.origensRaiz = std::move(origens);
+		pilhaBmssp.nivelRaiz = nivelInicial;
+		areaBmssp.buscaEmCurso = !areaBmssp.origensRaiz.empty();
+		if (areaBmssp.buscaEmCurso) empilhaBmssp(nivelInicial, INFINITO);
+	}
+
+	// O prazo só é consultado com orçamento de tempo; sem ele (execBmssp) o laço não lê o relógio
+	template <typename Vertice, typename Peso>
+	bool Algoritmo<Vertice, Peso>::continuaBmssp(std::chrono::microseconds tempo, size_t maxPassos)
+	{
+		bool temPrazo = tempo != std::chrono::microseconds::max();
+		auto prazo = std::chrono::steady_clock::now() + (temPrazo ? tempo : std::chrono::microseconds(0));
+
+		size_t passos = 0;
+		while (pilhaBmssp.nivelAtivo >= 0) {
+			passoBmssp();
+			if (++passos >= maxPassos || (temPrazo && std::chrono::steady_clock::now() >= prazo)) break;
+		}
+		return pilhaBmssp.nivelAtivo < 0;
+	}
+
+	template <typename Vertice, typename Peso>
+	long long Algoritmo<Vertice, Peso>::execDijkstraBidirecional(Vertice origem, Vertice alvo)
+	{
+		exigeGrafo("execDijkstraBidirecional");
+		exigeReverso();
+		alvosConsulta.clear();
+		pilhaBmssp.descarta();
+		if (!paraInterno.empty()) {
+			origem = paraInterno[origem];
+			alvo = paraInterno[alvo];
+		}
+
+		std::fill(distD.begin(), distD.end(), INFINITO);
+		distD[origem] = 0;
 
 		auto tempoInicial = std::chrono::high_resolution_clock::now();
-		bmssp(nivelInicial, INFINITO, { origem });
+		dijkstraBidirecional(origem, alvo);
 		auto duracao = std::chrono::high_resolution_clock::now() - tempoInicial;
 
+		ajustaRepresentantes(alvo);
 		return std::chrono::duration_cast<std::chrono::microseconds>(duracao).count();
 	}
 
-	void Algoritmo::setGrafo(const Grafo& grafo)
+	template <typename Vertice, typename Peso>
+	long long Algoritmo<Vertice, Peso>::execAEstrela(Vertice origem, Vertice alvo)
 	{
-		ptrGrafo = &grafo;
+		exigeGrafo("execAEstrela");
+		if (!tabelaLandmarks || tabelaLandmarks->vazia())
+			throw std::logic_error("execAEstrela: chame preprocessaLandmarks ou carregaLandmarks antes");
 
-		tamGrafo = ptrGrafo->size();
-		logN = std::log2(tamGrafo);
+		alvosConsulta.clear();
+		pilhaBmssp.descarta();
+		if (!paraInterno.empty()) {
+			origem = paraInterno[origem];
+			alvo = paraInterno[alvo];
+		}
+
+		std::fill(distD.begin(), distD.end(), INFINITO);
+		distD[origem] = 0;
 
-		maxContagemK = static_cast<size_t>(std::max(std::floor(std::pow(logN, 1.0 / 3.0)), 1.0));
-		passosT = static_cast<size_t>(std::max(std::floor(std::pow(logN, 2.0 / 3.0)), 1.0));
+		auto tempoInicial = std::chrono::high_resolution_clock::now();
+		aEstrela(origem, alvo);
+		auto duracao = std::chrono::high_resolution_clock::now() - tempoInicial;
+
+		ajustaRepresentantes(alvo);
+		return std::chrono::duration_cast<std::chrono::microseconds>(duracao).count();
+	}
+
+	// Nas buscas ponto a ponto só o caminho até o alvo é confiável. Com grauConstante ele pode atravessar as cópias de um
+	// vértice sem passar pelo representante, que é de onde getPredecessores lê; aponta o representante para o vértice
+	// anterior à primeira cópia do caminho
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::ajustaRepresentantes(Vertice alvo)
+	{
+		if (paraInterno.empty()) return;
+		// o caminho é copiado antes de mexer nos predecessores: com arestas de peso 0 ele pode passar duas vezes pelas
+		// cópias do mesmo vértice, e apontar o representante enquanto ainda se anda pela cadeia fecharia um ciclo nela.
+		// Andando do alvo para a origem, a última escrita em cada representante é a da primeira cópia no caminho
+		std::vector<Vertice>& caminho = areaBidirecional.caminho;
+		for (Vertice v = alvo; v != NULO; v = predecessores[v]) caminho.push_back(v);
+		for (size_t i = 0; i + 1 < caminho.size(); i++) {
+			Vertice v = caminho[i], pred = caminho[i + 1];
+			if (paraOriginal[pred] != paraOriginal[v]) predecessores[paraInterno[paraOriginal[v]]] = pred;
+		}
+		caminho.clear();
+	}
 
+	template <typename Vertice, typename Peso>
+	long long Algoritmo<Vertice, Peso>::execDeltaStepping(Vertice origem, Peso delta, size_t numThreads)
+	{
+		exigeGrafo("execDeltaStepping");
+		alvosConsulta.clear();
+		pilhaBmssp.descarta();
+		if (!paraInterno.empty()) origem = paraInterno[origem];
+
+		std::fill(distD.begin(), distD.end(), INFINITO);
+		distD[origem] = 0;
+
+		auto tempoInicial = std::chrono::high_resolution_clock::now();
+		deltaStepping(origem, delta, numThreads);
+		auto duracao = std::chrono::high_resolution_clock::now() - tempoInicial;
+
+		return std::chrono::duration_cast<std::chrono::microseconds>(duracao).count();
+	}
+
+	template <typename Vertice, typename Peso>
+	std::vector<Peso> Algoritmo<Vertice, Peso>::getDist() const
+	{
+		if (paraInterno.empty()) return distD;
+
+		// todas as cópias de um vértice têm a mesma distância, basta ler a do representante
+		std::vector<Peso> distOriginal(paraInterno.size());
+		for (size_t v = 0; v < paraInterno.size(); v++)
+			distOriginal[v] = distD[paraInterno[v]];
+		return distOriginal;
+	}
+
+	template <typename Vertice, typename Peso>
+	std::vector<Vertice> Algoritmo<Vertice, Peso>::getPredecessores() const
+	{
+		if (paraInterno.empty() || predecessores.empty()) return predecessores;
+
+		std::vector<Vertice> predOriginal(paraInterno.size(), NULO);
+		for (size_t v = 0; v < paraInterno.size(); v++) {
+			// o caminho pode chegar em outra cópia de v e dar a volta no ciclo até o representante
+			Vertice pred = predecessores[paraInterno[v]];
+			while (pred != NULO && paraOriginal[pred] == v) pred = predecessores[pred];
+			if (pred != NULO) predOriginal[v] = paraOriginal[pred];
+		}
+		return predOriginal;
+	}
+
+	// Sobe pelos predecessores internos e traduz para ids originais. Com grauConstante o caminho passa por cópias seguidas
+	// do mesmo vértice original, que viram uma entrada só
+	template <typename Vertice, typename Peso>
+	void ResultadoBusca<Vertice, Peso>::caminho(Vertice alvo, std::vector<Vertice>& saida) const
+	{
+		constexpr Vertice NULO = Algoritmo<Vertice, Peso>::NULO;
+		saida.clear();
+		Vertice v = paraInterno.empty() ? alvo : paraInterno[alvo];
+		if (!(dist[v] < Algoritmo<Vertice, Peso>::INFINITO)) return;
+
+		for (; v != NULO; v = predecessores[v]) {
+			Vertice original = paraOriginal.empty() ? v : paraOriginal[v];
+			if (saida.empty() || saida.back() != original) saida.push_back(original);
+		}
+		std::reverse(saida.begin(), saida.end());
+	}
+
+	template <typename Vertice, typename Peso>
+	GrafoCSR<Vertice, Peso> converteParaCSR(const Grafo& grafo)
+	{
+		GrafoCSR<Vertice, Peso> csr;
+		size_t tamanho = grafo.size();
+
+		// o maior valor de Vertice fica reservado para NULO
+		if (tamanho >= static_cast<size_t>(std::numeric_limits<Vertice>::max()))
+			throw std::length_error("converteParaCSR: grafo grande demais para o tipo de vertice escolhido");
+
+		csr.inicios.resize(tamanho + 1);
+		csr.inicios[0] = 0;
+		for (size_t u = 0; u < tamanho; u++)
+			csr.inicios[u + 1] = csr.inicios[u] + grafo[u].size();
+
+		csr.destinos.reserve(csr.inicios[tamanho]);
+		csr.pesos.reserve(csr.inicios[tamanho]);
+		for (const auto& vizinhos : grafo) {
+			for (const auto& [destino, peso] : vizinhos) {
+				csr.destinos.push_back(static_cast<Vertice>(destino));
+				csr.pesos.push_back(static_cast<Peso>(peso));
+			}
+		}
+		return csr;
+	}
+
+	template <typename Vertice, typename Peso>
+	GrafoCSR<Vertice, Peso> transpoeGrafo(const VisaoCSR<Vertice, Peso>& grafo)
+	{
+		GrafoCSR<Vertice, Peso> reverso;
+		size_t tamanho = grafo.tamanho();
+
+		// counting sort pelo destino: conta o grau de entrada e depois espalha as arestas
+		reverso.inicios.assign(tamanho + 1, 0);
+		for (Vertice destino : grafo.destinos) reverso.inicios[destino + 1]++;
+		for (size_t v = 0; v < tamanho; v++) reverso.inicios[v + 1] += reverso.inicios[v];
+
+		std::vector<size_t> proximaPosicao(reverso.inicios.begin(), reverso.inicios.end() - 1);
+		reverso.destinos.resize(grafo.numArestas());
+		reverso.pesos.resize(grafo.numArestas());
+		for (size_t u = 0; u < tamanho; u++) {
+			for (size_t aresta = grafo.inicios[u]; aresta < grafo.inicios[u + 1]; aresta++) {
+				size_t posicao = proximaPosicao[grafo.destinos[aresta]]++;
+				reverso.destinos[posicao] = static_cast<Vertice>(u);
+				reverso.pesos[posicao] = grafo.pesos[aresta];
+			}
+		}
+		return reverso;
+	}
+
+	// Preenche o que depende só da visão: o tamanho, a faixa de pesos e os parâmetros do BMSSP. O grafo reverso fica para exigeReverso
+	template <typename Vertice, typename Peso>
+	static void preparaVisao(GrafoPreparado<Vertice, Peso>& preparado, const VisaoCSR<Vertice, Peso>& visao)
+	{
+		preparado.visao = visao;
+		preparado.tamanho = visao.tamanho();
+		preparado.logN = std::log2(preparado.tamanho);
+		if (!visao.pesos.empty()) {
+			auto [menor, maior] = std::minmax_element(visao.pesos.begin(), visao.pesos.end());
+			preparado.pesoMinimo = *menor;
+			preparado.pesoMaximo = *maior;
+		}
+
+		preparado.maxContagemK = static_cast<size_t>(std::max(std::floor(std::pow(preparado.logN, 1.0 / 3.0)), 1.0));
+		preparado.passosT = static_cast<size_t>(std::max(std::floor(std::pow(preparado.logN, 2.0 / 3.0)), 1.0));
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::associaGrafo(std::shared_ptr<const GrafoPreparado<Vertice, Peso>> preparado)
+	{
+		grafoCompartilhado = std::move(preparado);
+		visaoGrafo = grafoCompartilhado->visao;
+		visaoReversa = {};
+		paraInterno = grafoCompartilhado->paraInterno;
+		paraOriginal = grafoCompartilhado->paraOriginal;
+		tamGrafo = grafoCompartilhado->tamanho;
+		maxContagemK = grafoCompartilhado->maxContagemK;
+		passosT = grafoCompartilhado->passosT;
+		logN = grafoCompartilhado->logN;
+
+		predecessores.clear();
+		pilhaBmssp.descarta();
 		distD.resize(tamGrafo);
+		heapIndexado.redimensiona(tamGrafo);
+		heapIndexadoReverso.redimensiona(tamGrafo);
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::preparaAreaBmssp(int nivelInicial)
+	{
+		if (areaBmssp.florestaF.size() != tamGrafo) {
+			areaBmssp.florestaF.assign(tamGrafo, NULO);
+			areaBmssp.camada.assign(tamGrafo, NULO);
+			areaBmssp.alcancadosW.assign(tamGrafo, false);
+			areaBmssp.camadaMarcada.assign(tamGrafo, 0);
+			areaBmssp.geracaoCamada = 0;
+			areaBmssp.indiceW.assign(tamGrafo, 0);
+			areaBmssp.niveis.clear();
+		}
+		else if (areaBmssp.buscaEmCurso) {
+			// a busca anterior foi largada no meio (outra exec*, associaGrafo ou cpia de um Algoritmo pausado): cada
+			// chamada que estava ativa deixou marcado em resolvidos o U parcial dela, que s seria limpo no fim da chamada
+			for (auto& nivel : areaBmssp.niveis) std::fill(nivel.resolvidos.begin(), nivel.resolvidos.end(), false);
+			// e se parou no meio de um findPivots, o W parcial dele ainda tem pai, camada e marca
+			std::fill(areaBmssp.florestaF.begin(), areaBmssp.florestaF.end(), NULO);
+			std::fill(areaBmssp.camada.begin(), areaBmssp.camada.end(), NULO);
+			std::fill(areaBmssp.alcancadosW.begin(), areaBmssp.alcancadosW.end(), false);
+		}
+		while (areaBmssp.niveis.size() <= static_cast<size_t>(std::max(nivelInicial, 0)))
+			areaBmssp.niveis.emplace_back();
+		areaBmssp.resolvidosRaiz.clear();
+		if (pilhaBmssp.quadros.size() < areaBmssp.niveis.size()) pilhaBmssp.quadros.resize(areaBmssp.niveis.size());
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::compartilhaGrafo(const Algoritmo& outro)
+	{
+		if (this == &outro) return;
+		tabelaLandmarks = outro.tabelaLandmarks;
+		filaDijkstra = outro.filaDijkstra;
+		associaGrafo(outro.grafoCompartilhado);
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::setGrafo(const Grafo& grafo)
+	{
+		auto preparado = std::make_shared<GrafoPreparado<Vertice, Peso>>();
+		preparado->armazenado = converteParaCSR<Vertice, Peso>(grafo);
+		preparaVisao(*preparado, preparado->armazenado.visao());
+		tabelaLandmarks.reset();
+		associaGrafo(std::move(preparado));
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::setGrafo(const GrafoCSR<Vertice, Peso>& grafo)
+	{
+		setGrafo(grafo.visao());
 	}
-}
 
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::setGrafo(const VisaoCSR<Vertice, Peso>& grafo)
+	{
+		auto preparado = std::make_shared<GrafoPreparado<Vertice, Peso>>();
+		preparaVisao(*preparado, grafo);
+		tabelaLandmarks.reset();
+		associaGrafo(std::move(preparado));
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::setGrafo(const VisaoCSR<Vertice, Peso>& grafo, const OpcoesPreprocessamento& opcoes)
+	{
+		if (!opcoes.grauConstante && opcoes.ordenacao == Ordenacao::Nenhuma) {
+			setGrafo(grafo);
+			return;
+		}
+
+		auto tempoInicial = std::chrono::high_resolution_clock::now();
+		auto preparado = std::make_shared<GrafoPreparado<Vertice, Peso>>();
+		std::vector<Vertice>& novoParaInterno = preparado->paraInterno;
+		std::vector<Vertice>& novoParaOriginal = preparado->paraOriginal;
+
+		if (opcoes.grauConstante) {
+			auto transformado = transformaGrauConstante(grafo, opcoes.grauMaximo);
+			preparado->armazenado = std::move(transformado.grafo);
+			novoParaInterno = std::move(transformado.representante);
+			novoParaOriginal = std::move(transformado.original);
+		}
+		else {
+			// começa da identidade para compor com a renumeração abaixo
+			novoParaInterno.resize(grafo.tamanho());
+			for (size_t v = 0; v < novoParaInterno.size(); v++) novoParaInterno[v] = static_cast<Vertice>(v);
+			novoParaOriginal = novoParaInterno;
+		}
+
+		if (opcoes.ordenacao != Ordenacao::Nenhuma) {
+			VisaoCSR<Vertice, Peso> atual = opcoes.grauConstante ? preparado->armazenado.visao() : grafo;
+			std::vector<Vertice> novoId = calculaOrdem(atual, opcoes.ordenacao);
+			GrafoCSR<Vertice, Peso> permutado = permutaGrafo(atual, novoId);
+
+			std::vector<Vertice> originalPermutado(novoParaOriginal.size());
+			for (size_t x = 0; x < novoParaOriginal.size(); x++) originalPermutado[novoId[x]] = novoParaOriginal[x];
+			for (Vertice& interno : novoParaInterno) interno = novoId[interno];
+
+			novoParaOriginal = std::move(originalPermutado);
+			preparado->armazenado = std::move(permutado);
+		}
+
+		auto duracao = std::chrono::high_resolution_clock::now() - tempoInicial;
+		preparado->opcoes = opcoes;
+		preparado->tempoPreprocessamento = std::chrono::duration_cast<std::chrono::microseconds>(duracao).count();
+
+		preparaVisao(*preparado, preparado->armazenado.visao());
+		tabelaLandmarks.reset();
+		associaGrafo(std::move(preparado));
+	}
+
+#define INSTANCIA_ALGORITMO(V, P) \
+	template GrafoCSR<V, P> converteParaCSR<V, P>(const Grafo&); \
+	template GrafoCSR<V, P> transpoeGrafo<V, P>(const VisaoCSR<V, P>&); \
+	template long long Algoritmo<V, P>::execDijkstra(V); \
+	template long long Algoritmo<V, P>::execBmssp(V); \
+	template long long Algoritmo<V, P>::execDijkstra(V, const std::vector<V>&); \
+	template long long Algoritmo<V, P>::execBmssp(V, const std::vector<V>&); \
+	template long long Algoritmo<V, P>::execDijkstra(const std::vector<V>&, const std::vector<P>&); \
+	template long long Algoritmo<V, P>::execBmssp(const std::vector<V>&, const std::vector<P>&); \
+	template void Algoritmo<V, P>::iniciaBmssp(V, const std::vector<V>&); \
+	template void Algoritmo<V, P>::iniciaBmssp(const std::vector<V>&, const std::vector<P>&); \
+	template void Algoritmo<V, P>::iniciaPilhaBmssp(std::vector<V>); \
+	template bool Algoritmo<V, P>::continuaBmssp(std::chrono::microseconds, size_t); \
+	template void Algoritmo<V, P>::defineAlvos(const std::vector<V>&); \
+	template std::vector<V> Algoritmo<V, P>::inicializaOrigens(const std::vector<V>&, const std::vector<P>&); \
+	template void Algoritmo<V, P>::exigeGrafo(const char*) const; \
+	template void Algoritmo<V, P>::exigeReverso(); \
+	template long long Algoritmo<V, P>::execDijkstraBidirecional(V, V); \
+	template long long Algoritmo<V, P>::execAEstrela(V, V); \
+	template void Algoritmo<V, P>::ajustaRepresentantes(V); \
+	template long long Algoritmo<V, P>::execDeltaStepping(V, P, size_t); \
+	template void Algoritmo<V, P>::setGrafo(const Grafo&); \
+	template void Algoritmo<V, P>::setGrafo(const GrafoCSR<V, P>&); \
+	template void Algoritmo<V, P>::setGrafo(const VisaoCSR<V, P>&); \
+	template void Algoritmo<V, P>::setGrafo(const VisaoCSR<V, P>&, const OpcoesPreprocessamento&); \
+	template void Algoritmo<V, P>::associaGrafo(std::shared_ptr<const GrafoPreparado<V, P>>); \
+	template void Algoritmo<V, P>::preparaAreaBmssp(int); \
+	template void Algoritmo<V, P>::compartilhaGrafo(const Algoritmo<V, P>&); \
+	template std::vector<P> Algoritmo<V, P>::getDist() const; \
+	template std::vector<V> Algoritmo<V, P>::getPredecessores() const; \
+	template void ResultadoBusca<V, P>::caminho(V, std::vector<V>&) const;
+
+	CAMINHOMINIMO_TIPOS(INSTANCIA_ALGORITMO)
+}
@@ -0,0 +1,119 @@
+#include "../headers/arquivoMapeado.hpp"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace CaminhoMinimo {
+	ArquivoMapeado::ArquivoMapeado(const std::string& caminho)
+	{
+#ifdef _WIN32
+		HANDLE arquivo = CreateFileA(caminho.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (arquivo == INVALID_HANDLE_VALUE)
+			throw std::runtime_error("ArquivoMapeado: nao foi possivel abrir " + caminho);
+		handleArquivo = arquivo;
+
+		LARGE_INTEGER tamanhoArquivo;
+		if (!GetFileSizeEx(arquivo, &tamanhoArquivo)) {
+			fecha();
+			throw std::runtime_error("ArquivoMapeado: nao foi possivel obter o tamanho de " + caminho);
+		}
+		tamDados = static_cast<size_t>(tamanhoArquivo.QuadPart);
+		if (tamDados == 0) return; // não dá para mapear um arquivo vazio
+
+		HANDLE mapeamento = CreateFileMappingA(arquivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapeamento == nullptr) {
+			fecha();
+			throw std::runtime_error("ArquivoMapeado: falha em CreateFileMapping para " + caminho);
+		}
+		handleMapeamento = mapeamento;
+
+		ptrDados = static_cast<const char*>(MapViewOfFile(mapeamento, FILE_MAP_READ, 0, 0, 0));
+		if (ptrDados == nullptr) {
+			fecha();
+			throw std::runtime_error("ArquivoMapeado: falha em MapViewOfFile para " + caminho);
+		}
+#else
+		descritor = open(caminho.c_str(), O_RDONLY);
+		if (descritor < 0)
+			throw std::runtime_error("ArquivoMapeado: nao foi possivel abrir " + caminho);
+
+		struct stat informacoes;
+		if (fstat(descritor, &informacoes) != 0) {
+			fecha();
+			throw std::runtime_error("ArquivoMapeado: nao foi possivel obter o tamanho de " + caminho);
+		}
+		tamDados = static_cast<size_t>(informacoes.st_size);
+		if (tamDados == 0) return; // não dá para mapear um arquivo vazio
+
+		void* endereco = mmap(nullptr, tamDados, PROT_READ, MAP_SHARED, descritor, 0);
+		if (endereco == MAP_FAILED) {
+			fecha();
+			throw std::runtime_error("ArquivoMapeado: falha em mmap para " + caminho);
+		}
+		ptrDados = static_cast<const char*>(endereco);
+#endif
+	}
+
+	ArquivoMapeado::~ArquivoMapeado()
+	{
+		fecha();
+	}
+
+	ArquivoMapeado::ArquivoMapeado(ArquivoMapeado&& outro) noexcept
+	{
+		tomaDe(outro);
+	}
+
+	ArquivoMapeado& ArquivoMapeado::operator=(ArquivoMapeado&& outro) noexcept
+	{
+		if (this != &outro) {
+			fecha();
+			tomaDe(outro);
+		}
+		return *this;
+	}
+
+	void ArquivoMapeado::tomaDe(ArquivoMapeado& outro)
+	{
+		ptrDados = outro.ptrDados;
+		tamDados = outro.tamDados;
+		outro.ptrDados = nullptr;
+		outro.tamDados = 0;
+#ifdef _WIN32
+		handleArquivo = outro.handleArquivo;
+		handleMapeamento = outro.handleMapeamento;
+		outro.handleArquivo = nullptr;
+		outro.handleMapeamento = nullptr;
+#else
+		descritor = outro.descritor;
+		outro.descritor = -1;
+#endif
+	}
+
+	void ArquivoMapeado::fecha()
+	{
+#ifdef _WIN32
+		if (ptrDados != nullptr) UnmapViewOfFile(ptrDados);
+		if (handleMapeamento != nullptr) CloseHandle(handleMapeamento);
+		if (handleArquivo != nullptr) CloseHandle(handleArquivo);
+		handleMapeamento = nullptr;
+		handleArquivo = nullptr;
+#else
+		if (ptrDados != nullptr) munmap(const_cast<char*>(ptrDados), tamDados);
+		if (descritor >= 0) close(descritor);
+		descritor = -1;
+#endif
+		ptrDados = nullptr;
+		tamDados = 0;
+	}
+}
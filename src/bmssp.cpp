@@ -3,33 +3,35 @@
 
 #define FINDPIVOTS
 #include <vector>
-#include <stack>
 #include <algorithm>
+#include <cassert>
 #include <cmath>
-#include <unordered_set>
 
 namespace CaminhoMinimo {
+    // Arestas que o findPivots e a etapa Retorno relaxam por passo. Sem isso as k rodadas sobre um S grande, ou um U_i
+    // grande perto da raiz (e as inserções em D que ele gera), virariam um passo só, e uma fatia de continuaBmssp
+    // poderia passar muito do orçamento
+    constexpr size_t ARESTASPORPASSO = 1024;
+
 #ifndef FINDPIVOTS
-    std::pair<std::vector<size_t>, std::vector<size_t>> Algoritmo::findPivots(double limiteB, std::vector<size_t> fronteiraInicialS)
+    template <typename Vertice, typename Peso>
+    void Algoritmo<Vertice, Peso>::findPivots(Peso limiteB, std::span<const Vertice> fronteiraInicialS, std::vector<Vertice>& pivotsRetorno, std::vector<Vertice>& verticesAlcancadosWRetorno)
     {
-        std::vector<size_t> florestaF(tamGrafo, NULO);
-        std::vector<size_t> camada(tamGrafo, NULO);
+        // vetores da areaBmssp: começam todos NULO/false e são devolvidos assim, limpando só as posições de W
+        std::vector<Vertice>& florestaF = areaBmssp.florestaF;
+        std::vector<Vertice>& camada = areaBmssp.camada;
+        std::vector<char>& verticesAlcancadosW = areaBmssp.alcancadosW; // W
 
-        for (size_t vertice : fronteiraInicialS) {
+        for (Vertice vertice : fronteiraInicialS) {
             camada[vertice] = 0;
         }
 
-        // Bellman-Ford
-        std::vector<char> verticesAlcancadosW(tamGrafo, false); // W
-        std::vector<size_t> verticesAlcancadosWRetorno;
-        std::vector<size_t> fronteiraAtualW_prev; // W_i-1. No caso: W_0
-
-        // reserve some space to reduce reallocations
-        //verticesAlcancadosWRetorno.reserve(fronteiraInicialS.size() * (maxContagemK > 0 ? maxContagemK : 1));
-        //fronteiraAtualW_prev.reserve(fronteiraInicialS.size());
-        fronteiraAtualW_prev = fronteiraInicialS;
-        verticesAlcancadosWRetorno = fronteiraInicialS;
-        for (size_t vertice : fronteiraInicialS) {
+        // Bellman-Ford. As fronteiras de cada camada são da areaBmssp; P e W são de quem chamou
+        std::vector<Vertice>& fronteiraAtualW_prev = areaBmssp.fronteiraAnterior; // W_i-1. No caso: W_0
+        fronteiraAtualW_prev.assign(fronteiraInicialS.begin(), fronteiraInicialS.end());
+        verticesAlcancadosWRetorno.assign(fronteiraInicialS.begin(), fronteiraInicialS.end());
+        pivotsRetorno.clear();
+        for (Vertice vertice : fronteiraInicialS) {
             //if (!verticesAlcancadosW[vertice]) {
                 verticesAlcancadosW[vertice] = true;
                 //verticesAlcancadosWRetorno.push_back(vertice);
@@ -37,39 +39,46 @@ namespace CaminhoMinimo {
             //}
         }
 
-        std::vector<size_t> proximaFronteiraW_i;
-        // reserve based on previous frontier size to reduce growth churn
-        proximaFronteiraW_i.reserve(fronteiraAtualW_prev.size() * 2 + 1);
+        std::vector<Vertice>& proximaFronteiraW_i = areaBmssp.proximaFronteira;
 
-        std::vector<char> adicionadoNestaCamada(tamGrafo, false); // para manter a ordem em que os vetores foram encontrados
+        std::vector<uint32_t>& camadaMarcada = areaBmssp.camadaMarcada; // para manter a ordem em que os vetores foram encontrados
+        auto limpaW = [&]() {
+            for (Vertice vertice : verticesAlcancadosWRetorno) {
+                florestaF[vertice] = NULO;
+                camada[vertice] = NULO;
+                verticesAlcancadosW[vertice] = false;
+            }
+        };
         for (size_t i = 0; i < maxContagemK; i++) // no algo: i = 1 até k.
         {
             proximaFronteiraW_i.clear();
-            std::fill(adicionadoNestaCamada.begin(), adicionadoNestaCamada.end(), false);
+            areaBmssp.proximaCamada(); // O(1) em vez de zerar n posições a cada camada
+            uint32_t geracao = areaBmssp.geracaoCamada;
 
-            for (size_t verticeU : fronteiraAtualW_prev) // vertice u da camada anterior
+            for (Vertice verticeU : fronteiraAtualW_prev) // vertice u da camada anterior
             {
-                const auto& vizinhos = ptrGrafo->at(verticeU);
-                for (const auto& [verticeDestinoV, pesoUV] : vizinhos) // vizinho de u(v)
+                for (size_t aresta = visaoGrafo.inicios[verticeU]; aresta < visaoGrafo.inicios[verticeU + 1]; aresta++) // vizinho de u(v)
                 {
-                    //size_t verticeDestinoV = aresta.first; // v
-                    //double pesoUV = aresta.second; // peso u -> v
+                    Vertice verticeDestinoV = visaoGrafo.destinos[aresta];
+                    Peso pesoUV = visaoGrafo.pesos[aresta];
 #ifdef LIMPARUIDO
-                    double novoCusto = limpaRuido(distD[verticeU] + pesoUV); // distD[u] + peso[u,v]
+                    Peso novoCusto = limpaRuido(distD[verticeU] + pesoUV); // distD[u] + peso[u,v]
 #else
-                    double novoCusto = distD[verticeU] + pesoUV; // distD[u] + peso[u,v]
+                    Peso novoCusto = distD[verticeU] + pesoUV; // distD[u] + peso[u,v]
 #endif
                     if (novoCusto <= distD[verticeDestinoV]) // novo menor caminho?
                     {
                         if (novoCusto < limiteB) { // B é limite de distancia(janela que me importo)
                             // W_i U {v}
-                            if (!adicionadoNestaCamada[verticeDestinoV]) {
-                                adicionadoNestaCamada[verticeDestinoV] = true;
+                            if (camadaMarcada[verticeDestinoV] != geracao) {
+                                camadaMarcada[verticeDestinoV] = geracao;
                                 proximaFronteiraW_i.push_back(verticeDestinoV);
                             }
                             // já que tem que pertencer a W:
                             bool melhorou = novoCusto < distD[verticeDestinoV];
-                            bool empateSeguro = (novoCusto == distD[verticeDestinoV]) && (florestaF[verticeDestinoV] == NULO || camada[verticeDestinoV] == i + 1);
+                            // no empate o pai precisa continuar na camada anterior: se ele também melhorou nesta camada, dois vértices
+                            // ligados por arestas de peso 0 podiam virar pai um do outro e fechar um ciclo em F
+                            bool empateSeguro = (novoCusto == distD[verticeDestinoV]) && camada[verticeU] == i && ((florestaF[verticeDestinoV] == NULO && camada[verticeDestinoV] != 0) || camada[verticeDestinoV] == i + 1);
 
                             if (melhorou || empateSeguro) {
                                 florestaF[verticeDestinoV] = verticeU;
@@ -77,6 +86,8 @@ namespace CaminhoMinimo {
                             }
                         }
 
+                        // pai só muda em melhora estrita, senão empates de peso 0 fechariam ciclos nos predecessores
+                        if (novoCusto < distD[verticeDestinoV]) predecessores[verticeDestinoV] = verticeU;
                         // Importante ser a última coisa a ser feita!
                         distD[verticeDestinoV] = novoCusto; // Atualiza menor distancia
                     }
@@ -84,7 +95,7 @@ namespace CaminhoMinimo {
             }
             fronteiraAtualW_prev.clear();
             // faz W U W_i
-            for (size_t vertice : proximaFronteiraW_i) {
+            for (Vertice vertice : proximaFronteiraW_i) {
                 if (!verticesAlcancadosW[vertice]) {
                     verticesAlcancadosW[vertice] = true;
                     verticesAlcancadosWRetorno.push_back(vertice);
@@ -92,332 +103,402 @@ namespace CaminhoMinimo {
                 fronteiraAtualW_prev.push_back(vertice); // precisamos fazer a fronteira atual ir para a anterior. W_i-1 = W_i implicito no artigo.
             }
 
-            if (verticesAlcancadosWRetorno.size() > maxContagemK * fronteiraInicialS.size())
-                return std::make_pair(fronteiraInicialS, verticesAlcancadosWRetorno); // retorna S direto já que P = S aqui.
-        }
-        // Construção de F: vetor florestaF já satisfaz as condições para pertencer a F. F == florestaF.
-        // filhos servem para construir P
-        std::vector<std::vector<size_t>> filhos(tamGrafo);
-
-        for (size_t vertice : verticesAlcancadosWRetorno) {
-            if (florestaF[vertice] != NULO) {
-                filhos[florestaF[vertice]].push_back(vertice);
+            if (verticesAlcancadosWRetorno.size() > maxContagemK * fronteiraInicialS.size()) {
+                limpaW();
+                pivotsRetorno.assign(fronteiraInicialS.begin(), fronteiraInicialS.end()); // retorna S direto já que P = S aqui.
+                return;
             }
         }
+        // Construção de F e de P
+        escolhePivots(fronteiraInicialS, verticesAlcancadosWRetorno, pivotsRetorno);
 
-        // Construção de P
-        std::vector<char> pivots(tamGrafo, false);
-        std::vector<size_t> pivotsRetorno;
-
-        for (size_t vertice : fronteiraInicialS) {
-            if (!verticesAlcancadosW[vertice] || florestaF[vertice] != NULO) continue;
-
-            // Usando um DFS para percorrer F e achar os pivots.
-            size_t contador = 0;
-            //std::set<int> visitados;
-            std::stack<size_t> pilha;
-
-            pilha.push(vertice);
-            //visitados.insert(vertice);
-
-            while (!pilha.empty()) {
-                size_t pai = pilha.top();
-                pilha.pop();
-                contador++;
-
-                if (contador >= maxContagemK) {
-                    if (!pivots[vertice]) {
-                        pivots[vertice] = true;
-                        pivotsRetorno.push_back(vertice);
-                    }
-                    break;
-                }
-                for (size_t v : filhos[pai]) {
-                    pilha.push(v);
-                }
-            }
+        limpaW();
+    }
+#endif
+    // P: raízes de F (vértices de S sem pai) cuja árvore tem pelo menos k vértices. F restrita a W vira um CSR de filhos
+    // montado por contagem; uma BFS a partir das raízes dá uma ordem com todo pai antes dos filhos, e o tamanho das árvores
+    // sai dessa ordem percorrida de trás para frente, sem DFS por raiz nem pilha. camada não serve de ordem aqui: com
+    // empates um vértice pode ganhar pai numa camada depois da dos próprios filhos
+    template <typename Vertice, typename Peso>
+    void Algoritmo<Vertice, Peso>::escolhePivots(std::span<const Vertice> fronteiraS, const std::vector<Vertice>& verticesAlcancadosW, std::vector<Vertice>& pivots)
+    {
+        const std::vector<Vertice>& florestaF = areaBmssp.florestaF;
+        std::vector<Vertice>& indiceW = areaBmssp.indiceW; // só é lido para vértices de W, então não precisa ser limpo
+        std::vector<size_t>& iniciosF = areaBmssp.iniciosF;
+        std::vector<Vertice>& filhosF = areaBmssp.filhosF;
+        std::vector<Vertice>& ordemF = areaBmssp.ordemF;
+        std::vector<size_t>& tamanhoF = areaBmssp.tamanhoF;
+        size_t tamW = verticesAlcancadosW.size();
+
+        for (size_t i = 0; i < tamW; i++) indiceW[verticesAlcancadosW[i]] = static_cast<Vertice>(i);
+
+        // filhos de W[i] em filhosF[iniciosF[i], iniciosF[i + 1]). O pai de um vértice de W está sempre em W.
+        // iniciosF[i] conta os filhos, vira o fim da faixa pela soma acumulada e volta ao início conforme ela é preenchida
+        iniciosF.assign(tamW + 1, 0);
+        for (Vertice vertice : verticesAlcancadosW)
+            if (florestaF[vertice] != NULO) iniciosF[indiceW[florestaF[vertice]]]++;
+        for (size_t i = 1; i <= tamW; i++) iniciosF[i] += iniciosF[i - 1];
+        filhosF.resize(iniciosF[tamW]);
+        for (Vertice vertice : verticesAlcancadosW)
+            if (florestaF[vertice] != NULO) filhosF[--iniciosF[indiceW[florestaF[vertice]]]] = vertice;
+
+        ordemF.clear();
+        for (Vertice vertice : fronteiraS)
+            if (florestaF[vertice] == NULO) ordemF.push_back(vertice);
+        size_t numRaizes = ordemF.size();
+        for (size_t i = 0; i < ordemF.size(); i++) {
+            size_t pai = indiceW[ordemF[i]];
+            ordemF.insert(ordemF.end(), filhosF.begin() + iniciosF[pai], filhosF.begin() + iniciosF[pai + 1]);
         }
+        // todo vértice de W desce de uma raiz de S. Se sobrou algum, F fechou um ciclo num empate e a raiz dele não vira pivô
+        assert(ordemF.size() == tamW);
+
+        tamanhoF.assign(tamW, 1);
+        for (size_t i = ordemF.size(); i-- > numRaizes;)
+            tamanhoF[indiceW[florestaF[ordemF[i]]]] += tamanhoF[indiceW[ordemF[i]]];
 
-        return std::make_pair(pivotsRetorno, verticesAlcancadosWRetorno);
+        for (size_t i = 0; i < numRaizes; i++)
+            if (tamanhoF[indiceW[ordemF[i]]] >= maxContagemK) pivots.push_back(ordemF[i]);
     }
-#endif
-    // mini-Dijkstra modificado
-    std::pair<double, std::vector<size_t>> Algoritmo::baseCase(double limiteB, size_t pivoFonteS) {
-        std::vector<size_t> verticesCompletosU_0; // a primeira iteração do while adiciona pivoFonteS
 
-        // fila de prioridades H: (distancia, vertice)
-        FilaPrioridade filaFronteiraH;
+    // mini-Dijkstra modificado. U_0 é montado direto no fim de verticesCompletosU, depois do que já estava lá
+    template <typename Vertice, typename Peso>
+    Peso Algoritmo<Vertice, Peso>::baseCase(Peso limiteB, Vertice pivoFonteS, std::vector<Vertice>& verticesCompletosU) {
+        const size_t inicioU = verticesCompletosU.size(); // a primeira iteração do while adiciona pivoFonteS
+
+        // fila de prioridades H: (distancia, vertice). O heap indexado é do objeto e precisa sair vazio daqui
+        HeapIndexado<Vertice, Peso>& filaFronteiraH = heapIndexado;
         filaFronteiraH.push({ distD[pivoFonteS], pivoFonteS });
 
-        while (!filaFronteiraH.empty() && verticesCompletosU_0.size() < maxContagemK + 1) {
+        while (!filaFronteiraH.empty() && verticesCompletosU.size() - inicioU < maxContagemK + 1) {
             auto minPar = filaFronteiraH.top();
             filaFronteiraH.pop();
 
-            double pesoAresta = minPar.first;
-            size_t verticeAtualU = minPar.second;
+            Peso pesoAresta = minPar.first;
+            Vertice verticeAtualU = minPar.second;
 
-            if (pesoAresta > distD[verticeAtualU]) continue; // isso cuida de duplicatas obsoletas na fila
+            if (pesoAresta > distD[verticeAtualU]) continue; // chave desatualizada (distD caiu por fora do heap)
+            // com arestas de peso 0 um vértice pode voltar para a fila com a mesma distância. U_0 tem no máximo k + 1 elementos
+            if (std::find(verticesCompletosU.begin() + inicioU, verticesCompletosU.end(), verticeAtualU) != verticesCompletosU.end()) continue;
 
-            verticesCompletosU_0.push_back(verticeAtualU); // cada vertice é adicionado somente uma vez por causa da verificação acima
+            verticesCompletosU.push_back(verticeAtualU);
 
-            const auto& vizinhos = ptrGrafo->at(verticeAtualU);
-            for (const auto& parVizinho : vizinhos) {
-                size_t vizinho = parVizinho.first; // vizinho é v - verticeAtualU é u
-                double pesoUV = parVizinho.second; // peso[u, v]
+            for (size_t aresta = visaoGrafo.inicios[verticeAtualU]; aresta < visaoGrafo.inicios[verticeAtualU + 1]; aresta++) {
+                Vertice vizinho = visaoGrafo.destinos[aresta]; // vizinho é v - verticeAtualU é u
+                Peso pesoUV = visaoGrafo.pesos[aresta]; // peso[u, v]
 #ifdef LIMPARUIDO
-                double novoCusto = limpaRuido(distD[verticeAtualU] + pesoUV);
+                Peso novoCusto = limpaRuido(distD[verticeAtualU] + pesoUV);
 #else
-                double novoCusto = distD[verticeAtualU] + pesoUV;
+                Peso novoCusto = distD[verticeAtualU] + pesoUV;
 #endif
                 if (novoCusto <= distD[vizinho] && novoCusto < limiteB) {
+                    if (novoCusto < distD[vizinho]) predecessores[vizinho] = verticeAtualU;
                     distD[vizinho] = novoCusto;
 
-                    // Não precisa verificar se já está na fila
+                    // se o vizinho já está no heap, push só diminui a chave dele
                     filaFronteiraH.push({ distD[vizinho], vizinho });
                 }
             }
         }
-        if (verticesCompletosU_0.size() <= maxContagemK)
-            return std::make_pair(limiteB, verticesCompletosU_0);
+        if (verticesCompletosU.size() - inicioU <= maxContagemK) {
+            filaFronteiraH.clear();
+            return limiteB;
+        }
         else {
             // Encontrando a distancia maxima em U_0
-            double Blinha = -std::numeric_limits<double>::infinity(); // isso funciona como o infinito do artigo
-            for (size_t vertice : verticesCompletosU_0)
-                if (Blinha < distD[vertice]) Blinha = distD[vertice];
-
-            // Construindo U para retorno(retirando vertices onde distancia < Blinha
-            std::vector<size_t> U;
-            U.reserve(verticesCompletosU_0.size());
-            for (size_t vertice : verticesCompletosU_0)
-                if (Blinha > distD[vertice]) U.push_back(vertice);
-
-            return std::make_pair(Blinha, U);
+            Peso Blinha = -std::numeric_limits<Peso>::infinity(); // isso funciona como o infinito do artigo
+            for (size_t i = inicioU; i < verticesCompletosU.size(); i++)
+                if (Blinha < distD[verticesCompletosU[i]]) Blinha = distD[verticesCompletosU[i]];
+
+            // Construindo U para retorno(retirando vertices onde distancia < Blinha), compactando U_0 no próprio lugar
+            size_t fimU = inicioU;
+            for (size_t i = inicioU; i < verticesCompletosU.size(); i++)
+                if (Blinha > distD[verticesCompletosU[i]]) verticesCompletosU[fimU++] = verticesCompletosU[i];
+
+            if (fimU == inicioU) {
+                // Todos empatados com a fonte (ex: ciclos de peso 0 da transformação de grau constante). Devolver U vazio
+                // com B' = d(fonte) faria o chamador puxar a mesma fonte para sempre, então fechamos todo o grupo
+                // empatado e devolvemos B' logo acima dele.
+                // completos da areaBmssp: marca o grupo e volta a zero no fim, percorrendo o mesmo U_0
+                std::vector<char>& completos = areaBmssp.completosBase;
+                if (completos.size() != tamGrafo) completos.assign(tamGrafo, false);
+                for (size_t i = inicioU; i < verticesCompletosU.size(); i++) completos[verticesCompletosU[i]] = true;
+
+                while (!filaFronteiraH.empty() && filaFronteiraH.top().first <= Blinha) {
+                    Vertice verticeAtualU = filaFronteiraH.top().second;
+                    filaFronteiraH.pop();
+                    if (completos[verticeAtualU]) continue;
+                    completos[verticeAtualU] = true;
+                    verticesCompletosU.push_back(verticeAtualU);
+
+                    for (size_t aresta = visaoGrafo.inicios[verticeAtualU]; aresta < visaoGrafo.inicios[verticeAtualU + 1]; aresta++) {
+                        Vertice vizinho = visaoGrafo.destinos[aresta];
+#ifdef LIMPARUIDO
+                        Peso novoCusto = limpaRuido(distD[verticeAtualU] + visaoGrafo.pesos[aresta]);
+#else
+                        Peso novoCusto = distD[verticeAtualU] + visaoGrafo.pesos[aresta];
+#endif
+                        if (novoCusto <= distD[vizinho] && novoCusto <= Blinha) {
+                            if (novoCusto < distD[vizinho]) predecessores[vizinho] = verticeAtualU;
+                            distD[vizinho] = novoCusto;
+                            filaFronteiraH.push({ novoCusto, vizinho });
+                        }
+                    }
+                }
+                for (size_t i = inicioU; i < verticesCompletosU.size(); i++) completos[verticesCompletosU[i]] = false;
+                filaFronteiraH.clear();
+                return std::nextafter(Blinha, limiteB);
+            }
+            verticesCompletosU.resize(fimU);
+            filaFronteiraH.clear();
+            return Blinha;
         }
     }
 
-    // Bounded Multi-Source Shortest Path(BMSSP)
-    std::pair<double, std::vector<size_t>> Algoritmo::bmssp(int nivel, double limiteSuperiorGlobalB, std::vector<size_t> fronteiraS) {
+    // Abre a chamada de nível nivel com limite B. Ela começa pelo findPivots no próximo passoBmssp
+    template <typename Vertice, typename Peso>
+    void Algoritmo<Vertice, Peso>::empilhaBmssp(int nivel, Peso limiteB) {
+        QuadroBmssp& quadro = pilhaBmssp.quadros[nivel];
+        quadro.etapa = EtapaBmssp::Pivots;
+        quadro.pivotsIniciados = false;
+        quadro.limiteB = limiteB;
+        quadro.inicioU = resolvidosDoNivel(nivel).size(); // U desta chamada é acrescentado no vetor de quem chamou a partir daqui
+        pilhaBmssp.nivelAtivo = nivel;
+    }
+
+    // Bounded Multi-Source Shortest Path(BMSSP), um passo por vez. A recursão do artigo vira a pilhaBmssp: a chamada do
+    // topo roda até precisar da de baixo (Pull empilha o nível - 1 e fica em Retorno) ou até terminar (devolve B' em
+    // retornoFilho e o quadro de cima volta a ser o topo)
+    template <typename Vertice, typename Peso>
+    void Algoritmo<Vertice, Peso>::passoBmssp() {
+        const int nivel = pilhaBmssp.nivelAtivo;
+        QuadroBmssp& quadro = pilhaBmssp.quadros[nivel];
+        const Peso limiteSuperiorGlobalB = quadro.limiteB;
+        std::span<const Vertice> fronteiraS = fronteiraDoNivel(nivel);
+        std::vector<Vertice>& verticesResolvidosU = resolvidosDoNivel(nivel);
+        auto desempilha = [&](Peso limiteAlcancado) {
+            pilhaBmssp.retornoFilho = limiteAlcancado;
+            pilhaBmssp.nivelAtivo = nivel == pilhaBmssp.nivelRaiz ? -1 : nivel + 1;
+            if (nivel == pilhaBmssp.nivelRaiz) areaBmssp.buscaEmCurso = false; // todas as chamadas limparam as marcas delas
+        };
+
         if (nivel == 0) { // S é um singleton(único elemento)
-            return baseCase(limiteSuperiorGlobalB, fronteiraS[0]);
+            desempilha(baseCase(limiteSuperiorGlobalB, fronteiraS[0], verticesResolvidosU));
+            return;
         }
-#ifdef FINDPIVOTS
-        // VARIÁVEIS DE SAÍDA DE findPivots
-        std::vector<size_t> pivotsP;
-        std::vector<size_t> verticesAlcancadosW; // W final
+        typename AreaBmssp::NivelBmssp& nivelAtual = areaBmssp.niveis[nivel];
 
+        using ParDistVertice = typename D<Vertice, Peso>::ParDistVertice;
+        // VARIÁVEIS DE SAÍDA DE findPivots. P só é usado antes da primeira chamada de baixo, W também no fim
+        std::vector<Vertice>& pivotsP = areaBmssp.pivotsP;
+        std::vector<Vertice>& verticesAlcancadosW = nivelAtual.alcancadosW; // W final
+        // replace unordered_set with a dense boolean vector for faster membership checks
+        // (um por nível, da areaBmssp: as chamadas de baixo usam o delas enquanto este ainda está em uso)
+        std::vector<char>& setControleDuplicatas = nivelAtual.resolvidos;
+        std::vector<Vertice>& pivotsLoteAtual = nivelAtual.fronteiraLote;
+        std::vector<Vertice>& verticesResolvidosLote = nivelAtual.resolvidosLote;
+        std::vector<ParDistVertice>& paresExtraidosDoPull = areaBmssp.paresPull;
+        std::vector<ParDistVertice>& loteTemporarioK = areaBmssp.loteK;
+
+        switch (quadro.etapa) {
+        case EtapaBmssp::Pivots: {
+            if (setControleDuplicatas.size() != tamGrafo) setControleDuplicatas.assign(tamGrafo, false);
+#ifdef FINDPIVOTS
 // ===============================================
 //              INICIO FINDPIVOTS
 // ===============================================
-            std::vector<size_t> florestaF(tamGrafo, NULO);
-            std::vector<size_t> camada(tamGrafo, NULO);
-            std::vector<char> verticesAlcancadosW_Flag(tamGrafo, false); // W
-
-            for (size_t vertice : fronteiraS)  {
-                camada[vertice] = 0;
-                verticesAlcancadosW_Flag[vertice] = true;
-            }
+            // vetores da areaBmssp: começam todos NULO/false e são devolvidos assim no fim do bloco, limpando só as
+            // posições de W (só vértices que entram em W recebem pai, camada ou marca)
+            std::vector<Vertice>& florestaF = areaBmssp.florestaF;
+            std::vector<Vertice>& camada = areaBmssp.camada;
+            std::vector<char>& verticesAlcancadosW_Flag = areaBmssp.alcancadosW; // W
             // Bellman-Ford
-            std::vector<size_t> fronteiraAtualW_prev = fronteiraS;
-            verticesAlcancadosW = fronteiraS;
-
-            std::vector<size_t> proximaFronteiraW_i;
-            // reserve based on previous frontier size to reduce growth churn
-            proximaFronteiraW_i.reserve(fronteiraAtualW_prev.size() * 2 + 1);
+            std::vector<Vertice>& fronteiraAtualW_prev = areaBmssp.fronteiraAnterior;
+            std::vector<Vertice>& proximaFronteiraW_i = areaBmssp.proximaFronteira;
+            std::vector<uint32_t>& camadaMarcada = areaBmssp.camadaMarcada; // para manter a ordem em que os vetores foram encontrados
+
+            // As k rodadas andam em pedaços de ARESTASPORPASSO arestas, como a etapa Retorno: rodadaPivots e proximoPivot
+            // dizem onde o passo anterior parou. Até o fim do bloco só este quadro roda, então ninguém mexe nesses vetores
+            if (!quadro.pivotsIniciados) {
+                quadro.pivotsIniciados = true;
+                quadro.rodadaPivots = 0;
+                quadro.proximoPivot = 0;
+                pivotsP.clear();
+                for (Vertice vertice : fronteiraS)  {
+                    camada[vertice] = 0;
+                    verticesAlcancadosW_Flag[vertice] = true;
+                }
+                fronteiraAtualW_prev.assign(fronteiraS.begin(), fronteiraS.end());
+                verticesAlcancadosW.assign(fronteiraS.begin(), fronteiraS.end());
+                proximaFronteiraW_i.clear();
+                areaBmssp.proximaCamada(); // O(1) em vez de zerar n posições a cada camada
+            }
 
-            std::vector<char> adicionadoNestaCamada(tamGrafo, false); // para manter a ordem em que os vetores foram encontrados
-            do
+            size_t arestasNoPasso = 0;
+            while (true) // no algo: i = 1 até k.
             {
-                for (size_t i = 0; i < maxContagemK; i++) // no algo: i = 1 até k.
-                {
-                    proximaFronteiraW_i.clear();
-                    std::fill(adicionadoNestaCamada.begin(), adicionadoNestaCamada.end(), false);
+                const size_t i = quadro.rodadaPivots;
+                uint32_t geracao = areaBmssp.geracaoCamada;
 
-                    for (size_t verticeU : fronteiraAtualW_prev) // vertice u da camada anterior
+                while (quadro.proximoPivot < fronteiraAtualW_prev.size() && arestasNoPasso < ARESTASPORPASSO)
+                {
+                    Vertice verticeU = fronteiraAtualW_prev[quadro.proximoPivot++]; // vertice u da camada anterior
+                    arestasNoPasso += visaoGrafo.inicios[verticeU + 1] - visaoGrafo.inicios[verticeU];
+                    for (size_t aresta = visaoGrafo.inicios[verticeU]; aresta < visaoGrafo.inicios[verticeU + 1]; aresta++) // vizinho de u(v)
                     {
-                        const auto& vizinhos = ptrGrafo->at(verticeU);
-                        for (const auto& [verticeDestinoV, pesoUV] : vizinhos) // vizinho de u(v)
-                        {
+                        Vertice verticeDestinoV = visaoGrafo.destinos[aresta];
+                        Peso pesoUV = visaoGrafo.pesos[aresta];
 #ifdef LIMPARUIDO
-                            double novoCusto = limpaRuido(distD[verticeU] + pesoUV); // distD[u] + peso[u,v]
+                        Peso novoCusto = limpaRuido(distD[verticeU] + pesoUV); // distD[u] + peso[u,v]
 #else
-                            double novoCusto = distD[verticeU] + pesoUV; // distD[u] + peso[u,v]
+                        Peso novoCusto = distD[verticeU] + pesoUV; // distD[u] + peso[u,v]
 #endif
-                            if (novoCusto <= distD[verticeDestinoV]) // novo menor caminho?
-                            {
-                                if (novoCusto < limiteSuperiorGlobalB) { // B é limite de distancia(janela que me importo)
-                                    // W_i U {v}
-                                    if (!adicionadoNestaCamada[verticeDestinoV]) {
-                                        adicionadoNestaCamada[verticeDestinoV] = true;
-                                        proximaFronteiraW_i.push_back(verticeDestinoV);
-                                    }
-                                    // já que tem que pertencer a W:
-                                    bool melhorou = novoCusto < distD[verticeDestinoV];
-                                    bool empateSeguro = (novoCusto == distD[verticeDestinoV]) && (florestaF[verticeDestinoV] == NULO || camada[verticeDestinoV] == i + 1);
-
-                                    if (melhorou || empateSeguro) {
-                                        florestaF[verticeDestinoV] = verticeU;
-                                        camada[verticeDestinoV] = i + 1;
-                                    }
+                        if (novoCusto <= distD[verticeDestinoV]) // novo menor caminho?
+                        {
+                            if (novoCusto < limiteSuperiorGlobalB) { // B é limite de distancia(janela que me importo)
+                                // W_i U {v}
+                                if (camadaMarcada[verticeDestinoV] != geracao) {
+                                    camadaMarcada[verticeDestinoV] = geracao;
+                                    proximaFronteiraW_i.push_back(verticeDestinoV);
+                                }
+                                // já que tem que pertencer a W:
+                                bool melhorou = novoCusto < distD[verticeDestinoV];
+                                // no empate o pai precisa continuar na camada anterior: se ele também melhorou nesta camada, dois vértices
+                                // ligados por arestas de peso 0 podiam virar pai um do outro e fechar um ciclo em F
+                                bool empateSeguro = (novoCusto == distD[verticeDestinoV]) && camada[verticeU] == i && ((florestaF[verticeDestinoV] == NULO && camada[verticeDestinoV] != 0) || camada[verticeDestinoV] == i + 1);
+
+                                if (melhorou || empateSeguro) {
+                                    florestaF[verticeDestinoV] = verticeU;
+                                    camada[verticeDestinoV] = i + 1;
                                 }
-
-                                // Importante ser a última coisa a ser feita!
-                                distD[verticeDestinoV] = novoCusto; // Atualiza menor distancia
                             }
-                        }
-                    }
-                    fronteiraAtualW_prev.clear();
-                    // faz W U W_i
-                    for (size_t vertice : proximaFronteiraW_i) {
-                        if (!verticesAlcancadosW_Flag[vertice]) {
-                            verticesAlcancadosW_Flag[vertice] = true;
-                            verticesAlcancadosW.push_back(vertice);
-                        }
-                        // precisamos fazer a fronteira atual ir para a anterior. W_i-1 = W_i implicito no artigo.
-                        //fronteiraAtualW_prev.push_back(vertice); 
-                    }
-                    fronteiraAtualW_prev.swap(proximaFronteiraW_i);
-                    proximaFronteiraW_i.clear();
 
-                    if (verticesAlcancadosW.size() > maxContagemK * fronteiraS.size())
-                    {
-                        pivotsP = fronteiraS;
-                        break;
+                            if (novoCusto < distD[verticeDestinoV]) predecessores[verticeDestinoV] = verticeU;
+                            // Importante ser a última coisa a ser feita!
+                            distD[verticeDestinoV] = novoCusto; // Atualiza menor distancia
+                        }
                     }
                 }
-                // Construção de F: vetor florestaF já satisfaz as condições para pertencer a F. F == florestaF.
-                // filhos servem para construir P
-                std::vector<std::vector<size_t>> filhos(tamGrafo);
-
-                for (size_t vertice : verticesAlcancadosW) {
-                    if (florestaF[vertice] != NULO) {
-                        filhos[florestaF[vertice]].push_back(vertice);
+                if (quadro.proximoPivot < fronteiraAtualW_prev.size()) return; // continua a rodada no próximo passo
+
+                fronteiraAtualW_prev.clear();
+                // faz W U W_i
+                for (Vertice vertice : proximaFronteiraW_i) {
+                    if (!verticesAlcancadosW_Flag[vertice]) {
+                        verticesAlcancadosW_Flag[vertice] = true;
+                        verticesAlcancadosW.push_back(vertice);
                     }
                 }
+                // precisamos fazer a fronteira atual ir para a anterior. W_i-1 = W_i implicito no artigo.
+                fronteiraAtualW_prev.swap(proximaFronteiraW_i);
+                proximaFronteiraW_i.clear();
+                quadro.proximoPivot = 0;
+                quadro.rodadaPivots++;
 
-                // Construção de P
-                std::vector<char> pivots_Flag(tamGrafo, false);
-
-                for (size_t vertice : fronteiraS) {
-                    if (!verticesAlcancadosW_Flag[vertice] || florestaF[vertice] != NULO) continue;
-
-                    // Usando um DFS para percorrer F e achar os pivots.
-                    size_t contador = 0;
-                    //std::set<int> visitados;
-                    std::stack<size_t> pilha;
-
-                    pilha.push(vertice);
-                    //visitados.insert(vertice);
-
-                    while (!pilha.empty()) {
-                        size_t pai = pilha.top();
-                        pilha.pop();
-                        contador++;
-
-                        if (contador >= maxContagemK) {
-                            if (!pivots_Flag[vertice]) {
-                                pivots_Flag[vertice] = true;
-                                pivotsP.push_back(vertice);
-                            }
-                            break;
-                        }
-                        for (size_t v : filhos[pai]) {
-                            pilha.push(v);
-                        }
-                    }
+                if (verticesAlcancadosW.size() > maxContagemK * fronteiraS.size())
+                {
+                    pivotsP.assign(fronteiraS.begin(), fronteiraS.end()); // W passou de k|S|: P = S, sem montar F
+                    break;
                 }
-
-                //return std::make_pair(pivotsRetorno, verticesAlcancadosWRetorno);
-            } while (false);
+                if (quadro.rodadaPivots == maxContagemK) {
+                    // Construção de F e de P
+                    escolhePivots(fronteiraS, verticesAlcancadosW, pivotsP);
+                    break;
+                }
+                areaBmssp.proximaCamada();
+                if (arestasNoPasso >= ARESTASPORPASSO) return;
+            }
+            quadro.pivotsIniciados = false;
+            for (Vertice vertice : verticesAlcancadosW) {
+                florestaF[vertice] = NULO;
+                camada[vertice] = NULO;
+                verticesAlcancadosW_Flag[vertice] = false;
+            }
 // ===============================================
 //                 FIM FINDPIVOTS
 // ===============================================
 #else
-        auto resultadoPivots = findPivots(limiteSuperiorGlobalB, fronteiraS);
-        std::vector<size_t> pivotsP = resultadoPivots.first;
-        std::vector<size_t> verticesAlcancadosW = resultadoPivots.second;
+            findPivots(limiteSuperiorGlobalB, fronteiraS, pivotsP, verticesAlcancadosW);
 #endif
 
-        //size_t tamLoteM = size_t(std::pow(2, (nivel - 1) * passosT));
-        size_t tamLoteM = 1ULL << ((static_cast<size_t>(nivel) - 1) * passosT); // evita mexer com ponto flutuante. ULL = unsigned long long
+            //size_t tamLoteM = size_t(std::pow(2, (nivel - 1) * passosT));
+            size_t tamLoteM = 1ULL << ((static_cast<size_t>(nivel) - 1) * passosT); // evita mexer com ponto flutuante. ULL = unsigned long long
 
-        D estruturaD(tamLoteM, limiteSuperiorGlobalB);
-
-        double limiteInferiorAnterior;
-
-        if (pivotsP.empty())
-            limiteInferiorAnterior = limiteSuperiorGlobalB;
-        else {
-            double menor = distD[pivotsP[0]];
-            for (size_t vertice : pivotsP) {
-                double dist = distD[vertice];
-                if (menor > dist) menor = dist;
+            // um D por nível: só a primeira chamada do nível constrói, as outras reiniciam o mesmo objeto
+            if (quadro.estruturaD) quadro.estruturaD->reinicia(tamLoteM, limiteSuperiorGlobalB);
+            else quadro.estruturaD.emplace(tamLoteM, limiteSuperiorGlobalB);
+            D<Vertice, Peso>& estruturaD = *quadro.estruturaD;
+            for (Vertice vertice : pivotsP) {
+                estruturaD.insert(vertice, distD[vertice]);
             }
 
-            limiteInferiorAnterior = menor;
+            quadro.Bfinal = limiteSuperiorGlobalB;
+            // replace pow with integer shift when safe
+            size_t shift = static_cast<size_t>(nivel) * passosT;
+            double limite;
+            if (shift < (sizeof(unsigned long long) * 8 - 1))
+                limite = static_cast<double>(maxContagemK) * static_cast<double>(1ULL << shift);
+            else
+                limite = static_cast<double>(maxContagemK) * std::pow(2.0, static_cast<double>(shift));
+            quadro.limiteU = limite < static_cast<double>(std::numeric_limits<size_t>::max()) ? static_cast<size_t>(limite) : std::numeric_limits<size_t>::max();
+
+            quadro.etapa = EtapaBmssp::Pull;
+            return;
         }
-
-        for (size_t vertice : pivotsP) {
-            estruturaD.insert(vertice, distD[vertice]);
-        }
-
-        std::vector<size_t> verticesResolvidosU;
-        // replace unordered_set with a dense boolean vector for faster membership checks
-        std::vector<char> setControleDuplicatas(tamGrafo, 0);
-
-        double Bfinal = limiteSuperiorGlobalB;
-        // replace pow with integer shift when safe
-        size_t shift = static_cast<size_t>(nivel) * passosT;
-        double limite;
-        if (shift < (sizeof(unsigned long long) * 8 - 1))
-            limite = static_cast<double>(maxContagemK) * static_cast<double>(1ULL << shift);
-        else
-            limite = static_cast<double>(maxContagemK) * std::pow(2.0, static_cast<double>(shift));
-
-        while (verticesResolvidosU.size() < static_cast<size_t>(limite)) {
-            auto resultadoPull = estruturaD.pull();
-            double limiteSuperiorLoteBi = resultadoPull.first;
-            // avoid copying the vector if possible
-            std::vector<ParDistVertice> paresExtraidosDoPull = std::move(resultadoPull.second);
-
+        case EtapaBmssp::Pull: {
+            D<Vertice, Peso>& estruturaD = *quadro.estruturaD;
+            // O artigo supõe distâncias distintas. Com empates (várias origens com o mesmo deslocamento, ciclos de peso 0)
+            // o limite de tamanho pode chegar com vértices em D abaixo do B' que seria devolvido; eles não estariam em U
+            // nem seriam relaxados por quem chamou, então continuamos puxando até D não ter mais nada abaixo de B'
+            if (!(verticesResolvidosU.size() - quadro.inicioU < quadro.limiteU || estruturaD.menorChave() < quadro.Bfinal)) break;
+
+            Peso limiteSuperiorLoteBi = estruturaD.pull(paresExtraidosDoPull);
             if (paresExtraidosDoPull.empty())
             {
-                Bfinal = limiteSuperiorGlobalB;
+                quadro.Bfinal = limiteSuperiorGlobalB;
                 break;
             }
 
-            std::vector<size_t> pivotsLoteAtual;
-            pivotsLoteAtual.reserve(paresExtraidosDoPull.size());
+            pivotsLoteAtual.clear();
             for (const auto& par : paresExtraidosDoPull) {
                 pivotsLoteAtual.push_back(par.second);
             }
-            auto resultadoRecursivo = bmssp(nivel - 1, limiteSuperiorLoteBi, pivotsLoteAtual);
-
-            double limiteAlcancadoRecursao = resultadoRecursivo.first;
-            std::vector<size_t> verticesResolvidosLote = resultadoRecursivo.second;
-
-            Bfinal = limiteAlcancadoRecursao;
-
-            for (size_t v : verticesResolvidosLote) {
-                if (!setControleDuplicatas[v]) {
-                    verticesResolvidosU.push_back(v);
-                    setControleDuplicatas[v] = 1;
-                }
+            verticesResolvidosLote.clear();
+            quadro.limiteLote = limiteSuperiorLoteBi;
+            quadro.proximoResolvido = 0;
+            quadro.etapa = EtapaBmssp::Retorno;
+            empilhaBmssp(nivel - 1, limiteSuperiorLoteBi);
+            return;
+        }
+        case EtapaBmssp::Retorno: {
+            D<Vertice, Peso>& estruturaD = *quadro.estruturaD;
+            Peso limiteSuperiorLoteBi = quadro.limiteLote;
+            // U_i é relaxado em pedaços de ARESTASPORPASSO arestas, um por passo. B' fica em Bfinal desde o primeiro
+            if (quadro.proximoResolvido == 0) {
+                quadro.Bfinal = pilhaBmssp.retornoFilho;
+                loteTemporarioK.clear();
             }
+            Peso limiteAlcancadoRecursao = quadro.Bfinal;
+
+            size_t arestasNoPasso = 0;
+            while (quadro.proximoResolvido < verticesResolvidosLote.size() && arestasNoPasso < ARESTASPORPASSO) {
+                Vertice verticeU = verticesResolvidosLote[quadro.proximoResolvido++];
+                if (!setControleDuplicatas[verticeU]) {
+                    verticesResolvidosU.push_back(verticeU);
+                    setControleDuplicatas[verticeU] = 1;
+                }
 
-            std::vector<ParDistVertice> loteTemporarioK;
-            loteTemporarioK.reserve(verticesResolvidosLote.size() * 2 + pivotsLoteAtual.size());
-
-            for (size_t verticeU : verticesResolvidosLote) {
-                const auto& vizinhos = ptrGrafo->at(verticeU);
-                for (const auto& aresta : vizinhos) {
-                    size_t vizinhoV = aresta.first; // v
-                    double pesoUV = aresta.second; // peso u -> v
+                arestasNoPasso += visaoGrafo.inicios[verticeU + 1] - visaoGrafo.inicios[verticeU];
+                for (size_t aresta = visaoGrafo.inicios[verticeU]; aresta < visaoGrafo.inicios[verticeU + 1]; aresta++) {
+                    Vertice vizinhoV = visaoGrafo.destinos[aresta]; // v
+                    Peso pesoUV = visaoGrafo.pesos[aresta]; // peso u -> v
 #ifdef LIMPARUIDO
-                    double novoCusto = limpaRuido(distD[verticeU] + pesoUV);
+                    Peso novoCusto = limpaRuido(distD[verticeU] + pesoUV);
 #else
-                    double novoCusto = distD[verticeU] + pesoUV;
+                    Peso novoCusto = distD[verticeU] + pesoUV;
 #endif
                     if (novoCusto <= distD[vizinhoV]) {
+                        if (novoCusto < distD[vizinhoV]) predecessores[vizinhoV] = verticeU;
                         distD[vizinhoV] = novoCusto;
                         if ((novoCusto >= limiteSuperiorLoteBi && novoCusto < limiteSuperiorGlobalB))
                             estruturaD.insert(vizinhoV, novoCusto);
@@ -426,18 +507,27 @@ namespace CaminhoMinimo {
                     }
                 }
             }
+            if (quadro.proximoResolvido < verticesResolvidosLote.size()) return; // continua no próximo passo
 
-            for (size_t vertice : pivotsLoteAtual) {
+            for (Vertice vertice : pivotsLoteAtual) {
                 if (distD[vertice] >= limiteAlcancadoRecursao && distD[vertice] < limiteSuperiorLoteBi)
                     loteTemporarioK.push_back({ distD[vertice], vertice });
             }
 
             estruturaD.batchPrepend(loteTemporarioK);
-            limiteInferiorAnterior = limiteAlcancadoRecursao;
+
+            // Consulta com alvos: tudo abaixo de B' já está completo. Se os alvos estão lá, o resto desta chamada (e das
+            // de cima, que vão ver o mesmo B') não muda a distância deles; devolver B' < B é o mesmo retorno parcial do artigo
+            if (alvosResolvidos(limiteAlcancadoRecursao)) break;
+
+            quadro.etapa = EtapaBmssp::Pull;
+            return;
+        }
         }
 
-        for (size_t vertice : verticesAlcancadosW) {
-            if (distD[vertice] < Bfinal) {
+        // Fim da chamada: o que W alcançou abaixo de B' também está completo
+        for (Vertice vertice : verticesAlcancadosW) {
+            if (distD[vertice] < quadro.Bfinal) {
                 // Verifica se já processamos usando o set principal
                 if (!setControleDuplicatas[vertice]) {
                     verticesResolvidosU.push_back(vertice);
@@ -446,6 +536,21 @@ namespace CaminhoMinimo {
             }
         }
 
-        return std::make_pair(Bfinal, verticesResolvidosU);
+        for (size_t i = quadro.inicioU; i < verticesResolvidosU.size(); i++) setControleDuplicatas[verticesResolvidosU[i]] = 0;
+        desempilha(quadro.Bfinal);
     }
+
+#ifndef FINDPIVOTS
+#define INSTANCIA_FINDPIVOTS(V, P) \
+    template void Algoritmo<V, P>::findPivots(P, std::span<const V>, std::vector<V>&, std::vector<V>&);
+
+    CAMINHOMINIMO_TIPOS(INSTANCIA_FINDPIVOTS)
+#endif
+#define INSTANCIA_BMSSP(V, P) \
+    template P Algoritmo<V, P>::baseCase(P, V, std::vector<V>&); \
+    template void Algoritmo<V, P>::escolhePivots(std::span<const V>, const std::vector<V>&, std::vector<V>&); \
+    template void Algoritmo<V, P>::empilhaBmssp(int, P); \
+    template void Algoritmo<V, P>::passoBmssp();
+
+    CAMINHOMINIMO_TIPOS(INSTANCIA_BMSSP)
 }
@@ -0,0 +1,256 @@
+#include "../headers/carregaGrafo.hpp"
+#include "../headers/arquivoMapeado.hpp"
+#include "../headers/paralelo.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace CaminhoMinimo {
+	template <typename Vertice, typename Peso>
+	GrafoCSR<Vertice, Peso> constroiCSR(size_t numVertices, std::vector<std::vector<Aresta<Vertice, Peso>>>& listasArestas, size_t numThreads)
+	{
+		if (numVertices >= static_cast<size_t>(std::numeric_limits<Vertice>::max()))
+			throw std::length_error("constroiCSR: grafo grande demais para o tipo de vertice escolhido");
+
+		numThreads = std::min(resolveThreads(numThreads), std::max<size_t>(numVertices, 1));
+		size_t numListas = listasArestas.size();
+
+		// Os vértices são divididos em numThreads faixas contíguas; cada faixa depois é ordenada por uma thread só.
+		size_t tamFaixa = (numVertices + numThreads - 1) / numThreads;
+		if (tamFaixa == 0) tamFaixa = 1;
+
+		// 1. Conta quantas arestas de cada lista caem em cada faixa
+		std::vector<std::vector<size_t>> contagem(numListas, std::vector<size_t>(numThreads + 1, 0));
+		paraCadaThread(std::min(numThreads, std::max<size_t>(numListas, 1)), [&](size_t t) {
+			for (size_t lista = t; lista < numListas; lista += numThreads)
+				for (const auto& aresta : listasArestas[lista])
+					contagem[lista][static_cast<size_t>(aresta.origem) / tamFaixa]++;
+		});
+
+		// 2. Prefixo na ordem (faixa, lista): mantém a ordem original dentro de cada faixa
+		std::vector<size_t> inicioFaixa(numThreads + 1, 0);
+		size_t total = 0;
+		for (size_t faixa = 0; faixa < numThreads; faixa++) {
+			inicioFaixa[faixa] = total;
+			for (size_t lista = 0; lista < numListas; lista++) {
+				size_t quantidade = contagem[lista][faixa];
+				contagem[lista][faixa] = total; // vira a posição de escrita
+				total += quantidade;
+			}
+		}
+		inicioFaixa[numThreads] = total;
+
+		// 3. Espalha as arestas por faixa
+		std::vector<Aresta<Vertice, Peso>> particionadas(total);
+		paraCadaThread(std::min(numThreads, std::max<size_t>(numListas, 1)), [&](size_t t) {
+			for (size_t lista = t; lista < numListas; lista += numThreads) {
+				for (const auto& aresta : listasArestas[lista])
+					particionadas[contagem[lista][static_cast<size_t>(aresta.origem) / tamFaixa]++] = aresta;
+				std::vector<Aresta<Vertice, Peso>>().swap(listasArestas[lista]); // libera a memória da lista já copiada
+			}
+		});
+
+		// 4. Cada thread faz a ordenação por contagem dos vértices da sua faixa
+		GrafoCSR<Vertice, Peso> csr;
+		csr.inicios.assign(numVertices + 1, 0);
+		csr.destinos.resize(total);
+		csr.pesos.resize(total);
+
+		paraCadaThread(numThreads, [&](size_t faixa) {
+			size_t primeiro = std::min(faixa * tamFaixa, numVertices);
+			size_t ultimo = std::min(primeiro + tamFaixa, numVertices);
+
+			for (size_t i = inicioFaixa[faixa]; i < inicioFaixa[faixa + 1]; i++)
+				csr.inicios[static_cast<size_t>(particionadas[i].origem) + 1]++;
+
+			// inicios[u] passa a ser a posição de escrita de u; no fim ela aponta para o início de u + 1
+			size_t acumulado = inicioFaixa[faixa];
+			for (size_t u = primeiro; u < ultimo; u++) {
+				size_t grau = csr.inicios[u + 1];
+				csr.inicios[u + 1] = acumulado;
+				acumulado += grau;
+			}
+			for (size_t i = inicioFaixa[faixa]; i < inicioFaixa[faixa + 1]; i++) {
+				const auto& aresta = particionadas[i];
+				size_t posicao = csr.inicios[static_cast<size_t>(aresta.origem) + 1]++;
+				csr.destinos[posicao] = aresta.destino;
+				csr.pesos[posicao] = aresta.peso;
+			}
+		});
+		csr.inicios[0] = 0;
+
+		return csr;
+	}
+
+	// Mapeia o arquivo recusando arquivos vazios (o mapeamento de 0 bytes não tem ponteiro válido)
+	static ArquivoMapeado abreArquivoTexto(const std::string& caminho, const char* funcao)
+	{
+		ArquivoMapeado arquivo(caminho);
+		if (arquivo.tamanho() == 0)
+			throw std::runtime_error(std::string(funcao) + "(" + caminho + "): arquivo vazio");
+		return arquivo;
+	}
+
+	// Divide [dados, dados + tamanho) em numPedacos pedaços que começam sempre no início de uma linha.
+	static std::vector<const char*> divideEmLinhas(const char* dados, size_t tamanho, size_t numPedacos)
+	{
+		std::vector<const char*> limites(numPedacos + 1);
+		limites[0] = dados;
+		limites[numPedacos] = dados + tamanho;
+		for (size_t i = 1; i < numPedacos; i++) {
+			const char* nominal = std::max(dados + tamanho / numPedacos * i, limites[i - 1]);
+			if (nominal == dados + tamanho) {
+				limites[i] = nominal;
+				continue;
+			}
+			const char* quebra = static_cast<const char*>(std::memchr(nominal, '\n', static_cast<size_t>(dados + tamanho - nominal)));
+			limites[i] = (quebra == nullptr) ? dados + tamanho : quebra + 1;
+		}
+		return limites;
+	}
+
+	static const char* pulaEspacos(const char* p, const char* fim)
+	{
+		while (p < fim && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+		return p;
+	}
+
+	// Lê um número e avança p. Retorna false se não houver número válido na posição.
+	template <typename Numero>
+	static bool leNumero(const char*& p, const char* fim, Numero& valor)
+	{
+		p = pulaEspacos(p, fim);
+		auto resultado = std::from_chars(p, fim, valor);
+		if (resultado.ec != std::errc()) return false;
+		p = resultado.ptr;
+		return true;
+	}
+
+	// Interpreta as linhas de um pedaço do arquivo. interpretaLinha(inicio, fim) retorna false para linha inválida.
+	template <typename Interpretador>
+	static void percorreLinhas(const char* inicio, const char* fim, const char* base, Interpretador interpretaLinha)
+	{
+		const char* p = inicio;
+		while (p < fim) {
+			const char* fimLinha = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(fim - p)));
+			if (fimLinha == nullptr) fimLinha = fim;
+			if (!interpretaLinha(pulaEspacos(p, fimLinha), fimLinha))
+				throw std::runtime_error("linha invalida no byte " + std::to_string(p - base));
+			p = fimLinha + 1;
+		}
+	}
+
+	template <typename Vertice, typename Peso>
+	GrafoCSR<Vertice, Peso> leDimacs(const std::string& caminho, size_t numThreads)
+	{
+		ArquivoMapeado arquivo = abreArquivoTexto(caminho, "leDimacs");
+		numThreads = resolveThreads(numThreads);
+		std::vector<const char*> limites = divideEmLinhas(arquivo.dados(), arquivo.tamanho(), numThreads);
+
+		std::vector<std::vector<Aresta<Vertice, Peso>>> listasArestas(numThreads);
+		std::vector<size_t> numVerticesDeclarado(numThreads, 0);
+		std::vector<std::string> erros(numThreads);
+
+		paraCadaThread(numThreads, [&](size_t t) {
+			try {
+				auto& arestas = listasArestas[t];
+				percorreLinhas(limites[t], limites[t + 1], arquivo.dados(), [&](const char* p, const char* fim) {
+					if (p == fim || *p == 'c') return true;
+					if (*p == 'p') {
+						// "p sp <n> <m>"
+						p = pulaEspacos(p + 1, fim);
+						while (p < fim && *p != ' ' && *p != '\t') p++;
+						size_t n, m;
+						if (!leNumero(p, fim, n) || !leNumero(p, fim, m)) return false;
+						numVerticesDeclarado[t] = n;
+						arestas.reserve(m / numThreads + 1);
+						return true;
+					}
+					if (*p != 'a') return false;
+					p++;
+					size_t origem, destino;
+					Peso peso;
+					if (!leNumero(p, fim, origem) || !leNumero(p, fim, destino) || !leNumero(p, fim, peso)) return false;
+					if (origem == 0 || destino == 0) return false; // DIMACS começa em 1
+					if (std::max(origem, destino) > static_cast<size_t>(std::numeric_limits<Vertice>::max())) return false;
+					arestas.push_back({ static_cast<Vertice>(origem - 1), static_cast<Vertice>(destino - 1), peso });
+					return true;
+				});
+			}
+			catch (const std::exception& e) {
+				erros[t] = e.what();
+			}
+		});
+		for (const auto& erro : erros)
+			if (!erro.empty()) throw std::runtime_error("leDimacs(" + caminho + "): " + erro);
+
+		size_t numVertices = *std::max_element(numVerticesDeclarado.begin(), numVerticesDeclarado.end());
+		if (numVertices == 0)
+			throw std::runtime_error("leDimacs(" + caminho + "): linha 'p sp <n> <m>' ausente ou com n = 0");
+		for (const auto& arestas : listasArestas)
+			for (const auto& aresta : arestas)
+				if (static_cast<size_t>(aresta.origem) >= numVertices || static_cast<size_t>(aresta.destino) >= numVertices)
+					throw std::runtime_error("leDimacs(" + caminho + "): aresta com vertice maior que n");
+
+		return constroiCSR<Vertice, Peso>(numVertices, listasArestas, numThreads);
+	}
+
+	template <typename Vertice, typename Peso>
+	GrafoCSR<Vertice, Peso> leListaArestas(const std::string& caminho, size_t numThreads)
+	{
+		ArquivoMapeado arquivo = abreArquivoTexto(caminho, "leListaArestas");
+		numThreads = resolveThreads(numThreads);
+		std::vector<const char*> limites = divideEmLinhas(arquivo.dados(), arquivo.tamanho(), numThreads);
+
+		std::vector<std::vector<Aresta<Vertice, Peso>>> listasArestas(numThreads);
+		std::vector<size_t> maiorVertice(numThreads, 0);
+		std::vector<char> temAresta(numThreads, false);
+		std::vector<std::string> erros(numThreads);
+
+		paraCadaThread(numThreads, [&](size_t t) {
+			try {
+				auto& arestas = listasArestas[t];
+				// estimativa grosseira de ~16 bytes por linha para evitar realocações
+				arestas.reserve(static_cast<size_t>(limites[t + 1] - limites[t]) / 16);
+				percorreLinhas(limites[t], limites[t + 1], arquivo.dados(), [&](const char* p, const char* fim) {
+					if (p == fim || *p == '#' || *p == '%') return true;
+					size_t origem, destino;
+					Peso peso = 1;
+					if (!leNumero(p, fim, origem) || !leNumero(p, fim, destino)) return false;
+					if (pulaEspacos(p, fim) != fim && !leNumero(p, fim, peso)) return false;
+					if (std::max(origem, destino) >= static_cast<size_t>(std::numeric_limits<Vertice>::max())) return false;
+
+					maiorVertice[t] = std::max({ maiorVertice[t], origem, destino });
+					temAresta[t] = true;
+					arestas.push_back({ static_cast<Vertice>(origem), static_cast<Vertice>(destino), peso });
+					return true;
+				});
+			}
+			catch (const std::exception& e) {
+				erros[t] = e.what();
+			}
+		});
+		for (const auto& erro : erros)
+			if (!erro.empty()) throw std::runtime_error("leListaArestas(" + caminho + "): " + erro);
+
+		size_t numVertices = 0;
+		for (size_t t = 0; t < numThreads; t++)
+			if (temAresta[t]) numVertices = std::max(numVertices, maiorVertice[t] + 1);
+		if (numVertices == 0)
+			throw std::runtime_error("leListaArestas(" + caminho + "): nenhuma aresta no arquivo");
+		if (numVertices >= static_cast<size_t>(std::numeric_limits<Vertice>::max()))
+			throw std::length_error("leListaArestas(" + caminho + "): grafo grande demais para o tipo de vertice escolhido");
+
+		return constroiCSR<Vertice, Peso>(numVertices, listasArestas, numThreads);
+	}
+
+#define INSTANCIA_CARREGA_GRAFO(V, P) \
+	template GrafoCSR<V, P> constroiCSR<V, P>(size_t, std::vector<std::vector<Aresta<V, P>>>&, size_t); \
+	template GrafoCSR<V, P> leDimacs<V, P>(const std::string&, size_t); \
+	template GrafoCSR<V, P> leListaArestas<V, P>(const std::string&, size_t);
+
+	CAMINHOMINIMO_TIPOS(INSTANCIA_CARREGA_GRAFO)
+}
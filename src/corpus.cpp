@@ -0,0 +1,261 @@
+#include "../headers/corpus.hpp"
+#include "../headers/grafoBinario.hpp"
+#include "../headers/helpers.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace CaminhoMinimo {
+	static const char MAGICA_REGISTRO_CORPUS[8] = "BMSSPRG";
+	static const char MAGICA_INDICE_CORPUS[8] = "BMSSPIX";
+
+	struct CabecalhoIndiceCorpus {
+		char magica[8]; // "BMSSPIX"
+		uint32_t versao;
+		uint32_t reservado;
+	};
+
+	// Confere, sem estourar uint64, que [offset, offset + quantidade * largura) está alinhado e dentro de 'total'
+	static bool cabeNoRegistro(uint64_t offset, uint64_t quantidade, uint64_t largura, uint64_t total)
+	{
+		return offset % largura == 0 && offset <= total && quantidade <= (total - offset) / largura;
+	}
+
+	static uint64_t tamanhoDoArquivo(std::istream& arquivo)
+	{
+		arquivo.seekg(0, std::ios::end);
+		uint64_t tamanho = static_cast<uint64_t>(arquivo.tellg());
+		arquivo.seekg(0, std::ios::beg);
+		return tamanho;
+	}
+
+	// Cabeçalho de registro plausível para um registro que começa em 'inicio' num arquivo de 'tamanhoArquivo' bytes
+	static bool registroValido(const CabecalhoRegistroCorpus& cabecalho, uint64_t inicio, uint64_t tamanhoArquivo)
+	{
+		return std::memcmp(cabecalho.magica, MAGICA_REGISTRO_CORPUS, sizeof(cabecalho.magica)) == 0
+			&& cabecalho.versao == VERSAO_CORPUS
+			&& cabecalho.tamanhoId > 0 && cabecalho.tamanhoId <= TAMANHO_MAX_ID_CORPUS
+			&& cabecalho.tamanhoTotal >= sizeof(cabecalho) + cabecalho.tamanhoId
+			&& inicio <= tamanhoArquivo && cabecalho.tamanhoTotal <= tamanhoArquivo - inicio;
+	}
+
+	static void escreveCabecalhoIndice(std::ostream& saida)
+	{
+		CabecalhoIndiceCorpus cabecalho{};
+		std::memcpy(cabecalho.magica, MAGICA_INDICE_CORPUS, sizeof(cabecalho.magica));
+		cabecalho.versao = VERSAO_CORPUS;
+		saida.write(reinterpret_cast<const char*>(&cabecalho), sizeof(cabecalho));
+	}
+
+	CorpusGrafos::CorpusGrafos(const std::string& caminho) : caminhoDados(caminho), caminhoIndice(caminho + ".idx")
+	{
+		std::ifstream arquivoIndice(caminhoIndice, std::ios::binary);
+		if (!arquivoIndice.is_open()) {
+			std::ifstream dadosExistentes(caminhoDados, std::ios::binary);
+			if (dadosExistentes.is_open()) {
+				// dados sem índice (ex: .idx apagado): o índice é refeito a partir dos registros, nunca o contrário
+				reconstroiIndice(dadosExistentes);
+				return;
+			}
+
+			// corpus novo: cria o índice só com o cabeçalho e o arquivo de dados vazio
+			std::ofstream novoIndice(caminhoIndice, std::ios::binary | std::ios::trunc);
+			std::ofstream novosDados(caminhoDados, std::ios::binary | std::ios::trunc);
+			if (!novoIndice.is_open() || !novosDados.is_open())
+				throw std::runtime_error("corpus: nao foi possivel criar " + caminhoDados);
+			escreveCabecalhoIndice(novoIndice);
+			return;
+		}
+
+		uint64_t tamanhoIndice = tamanhoDoArquivo(arquivoIndice);
+		CabecalhoIndiceCorpus cabecalho{};
+		arquivoIndice.read(reinterpret_cast<char*>(&cabecalho), sizeof(cabecalho));
+		if (!arquivoIndice || std::memcmp(cabecalho.magica, MAGICA_INDICE_CORPUS, sizeof(cabecalho.magica)) != 0)
+			throw std::runtime_error("corpus: indice invalido em " + caminhoIndice);
+		if (cabecalho.versao != VERSAO_CORPUS)
+			throw std::runtime_error("corpus: versao " + std::to_string(cabecalho.versao) + " nao suportada");
+
+		EntradaIndiceCorpus entrada;
+		while (arquivoIndice.read(reinterpret_cast<char*>(&entrada), sizeof(entrada))) {
+			entrada.id[TAMANHO_MAX_ID_CORPUS] = '\0';
+			posicaoPorId[entrada.id] = indice.size();
+			indice.push_back(entrada);
+		}
+
+		// Uma entrada incompleta no final (escrita interrompida) fica de fora, mas o próximo acréscimo em modo app
+		// iria depois dela e desalinharia todas as entradas seguintes. O índice é regravado só com as inteiras
+		arquivoIndice.close();
+		if (tamanhoIndice != sizeof(CabecalhoIndiceCorpus) + indice.size() * sizeof(EntradaIndiceCorpus))
+			gravaIndice();
+	}
+
+	// Regrava o índice inteiro (cabeçalho e as entradas em memória) no lugar do que está em disco
+	void CorpusGrafos::gravaIndice()
+	{
+		std::ofstream novoIndice(caminhoIndice, std::ios::binary | std::ios::trunc);
+		escreveCabecalhoIndice(novoIndice);
+		novoIndice.write(reinterpret_cast<const char*>(indice.data()), static_cast<std::streamsize>(indice.size() * sizeof(EntradaIndiceCorpus)));
+		if (!novoIndice)
+			throw std::runtime_error("corpus: nao foi possivel recriar " + caminhoIndice);
+	}
+
+	void CorpusGrafos::reconstroiIndice(std::istream& dados)
+	{
+		uint64_t tamanhoArquivo = tamanhoDoArquivo(dados);
+
+		// Registros começam sempre em posições alinhadas. Um trecho que não é um registro válido (escrita
+		// interrompida antes do índice) é pulado de ALINHAMENTO_GRAFO_BINARIO em ALINHAMENTO_GRAFO_BINARIO bytes.
+		uint64_t posicao = 0;
+		while (posicao + sizeof(CabecalhoRegistroCorpus) <= tamanhoArquivo) {
+			CabecalhoRegistroCorpus cabecalho;
+			dados.seekg(static_cast<std::streamoff>(posicao));
+			dados.read(reinterpret_cast<char*>(&cabecalho), sizeof(cabecalho));
+			if (!dados || !registroValido(cabecalho, posicao, tamanhoArquivo)) {
+				dados.clear();
+				posicao += ALINHAMENTO_GRAFO_BINARIO;
+				continue;
+			}
+
+			EntradaIndiceCorpus entrada{};
+			dados.read(entrada.id, cabecalho.tamanhoId);
+			entrada.offset = posicao;
+			entrada.tamanho = cabecalho.tamanhoTotal;
+			posicaoPorId[entrada.id] = indice.size();
+			indice.push_back(entrada);
+			posicao = alinha(posicao + cabecalho.tamanhoTotal);
+		}
+		gravaIndice();
+	}
+
+	std::string CorpusGrafos::acrescenta(size_t tamanho, double densidade, const Grafo& grafo)
+	{
+		std::stringstream ss;
+		ss << "Grafo_N" << tamanho << "D" << std::fixed << std::setprecision(2) << densidade << "_" << quantidade() + 1;
+
+		auto solucao = bellmanFord(grafo);
+		acrescenta(ss.str(), tamanho, densidade, grafo, solucao.first, solucao.second);
+		return ss.str();
+	}
+
+	void CorpusGrafos::acrescenta(const std::string& id, size_t tamanho, double densidade, const Grafo& grafo,
+		const std::vector<double>& distancias, const std::vector<size_t>& predecessores)
+	{
+		if (id.empty() || id.size() > TAMANHO_MAX_ID_CORPUS)
+			throw std::invalid_argument("corpus: id vazio ou maior que " + std::to_string(TAMANHO_MAX_ID_CORPUS) + " caracteres");
+		if (contem(id))
+			throw std::invalid_argument("corpus: id repetido " + id);
+		if (distancias.size() != predecessores.size())
+			throw std::invalid_argument("corpus: distancias e predecessores com tamanhos diferentes");
+
+		GrafoCSR<size_t, double> csr = converteParaCSR<size_t, double>(grafo);
+		VisaoCSR<size_t, double> visao = csr.visao();
+
+		CabecalhoRegistroCorpus cabecalho{};
+		std::memcpy(cabecalho.magica, MAGICA_REGISTRO_CORPUS, sizeof(cabecalho.magica));
+		cabecalho.versao = VERSAO_CORPUS;
+		cabecalho.tamanhoId = static_cast<uint32_t>(id.size());
+		cabecalho.tamanho = tamanho;
+		cabecalho.densidade = densidade;
+		cabecalho.offsetGrafo = alinha(sizeof(cabecalho) + id.size());
+		cabecalho.tamanhoGrafo = tamanhoGrafoBinario(visao);
+		cabecalho.tamanhoSolucao = distancias.size();
+		cabecalho.offsetDistancias = cabecalho.offsetGrafo + cabecalho.tamanhoGrafo;
+		cabecalho.offsetPredecessores = alinha(cabecalho.offsetDistancias + distancias.size() * sizeof(double));
+		cabecalho.tamanhoTotal = alinha(cabecalho.offsetPredecessores + predecessores.size() * sizeof(uint64_t));
+
+		// 1. Registro no fim do arquivo de dados (alinhado para que a imagem do grafo possa ser mapeada)
+		std::fstream dados(caminhoDados, std::ios::binary | std::ios::in | std::ios::out);
+		if (!dados.is_open())
+			throw std::runtime_error("corpus: nao foi possivel abrir " + caminhoDados);
+		dados.seekp(0, std::ios::end);
+		uint64_t fimAtual = static_cast<uint64_t>(dados.tellp());
+		uint64_t inicioRegistro = alinha(fimAtual);
+		completaComZeros(dados, inicioRegistro - fimAtual);
+
+		dados.write(reinterpret_cast<const char*>(&cabecalho), sizeof(cabecalho));
+		dados.write(id.data(), static_cast<std::streamsize>(id.size()));
+		completaComZeros(dados, cabecalho.offsetGrafo - sizeof(cabecalho) - id.size());
+		escreveGrafoBinario(dados, visao);
+		dados.write(reinterpret_cast<const char*>(distancias.data()), static_cast<std::streamsize>(distancias.size() * sizeof(double)));
+		completaComZeros(dados, cabecalho.offsetPredecessores - cabecalho.offsetDistancias - distancias.size() * sizeof(double));
+		escreveComoUint64(dados, predecessores);
+		completaComZeros(dados, cabecalho.tamanhoTotal - cabecalho.offsetPredecessores - predecessores.size() * sizeof(uint64_t));
+		dados.flush();
+		if (!dados)
+			throw std::runtime_error("corpus: falha ao escrever em " + caminhoDados);
+
+		// 2. Só depois a entrada do índice: ela é o que torna o registro visível
+		EntradaIndiceCorpus entrada{};
+		std::memcpy(entrada.id, id.data(), id.size());
+		entrada.offset = inicioRegistro;
+		entrada.tamanho = cabecalho.tamanhoTotal;
+
+		std::ofstream arquivoIndice(caminhoIndice, std::ios::binary | std::ios::app);
+		arquivoIndice.write(reinterpret_cast<const char*>(&entrada), sizeof(entrada));
+		if (!arquivoIndice)
+			throw std::runtime_error("corpus: falha ao escrever em " + caminhoIndice);
+
+		posicaoPorId[id] = indice.size();
+		indice.push_back(entrada);
+	}
+
+	InstanciaCorpus CorpusGrafos::le(const std::string& id) const
+	{
+		auto iPosicao = posicaoPorId.find(id);
+		if (iPosicao == posicaoPorId.end())
+			throw std::out_of_range("corpus: id nao encontrado " + id);
+		return le(iPosicao->second);
+	}
+
+	InstanciaCorpus CorpusGrafos::le(size_t posicao) const
+	{
+		const EntradaIndiceCorpus& entrada = indice.at(posicao);
+
+		// o índice vem do disco: o registro precisa caber no arquivo antes de alocar o buffer para ele
+		std::ifstream dados(caminhoDados, std::ios::binary);
+		uint64_t tamanhoArquivo = tamanhoDoArquivo(dados);
+		if (!dados || entrada.tamanho < sizeof(CabecalhoRegistroCorpus)
+			|| entrada.offset > tamanhoArquivo || entrada.tamanho > tamanhoArquivo - entrada.offset)
+			throw std::runtime_error("corpus: registro fora do arquivo para " + std::string(entrada.id));
+
+		// lê só os bytes deste registro; uint64_t garante o alinhamento que a VisaoCSR precisa
+		std::vector<uint64_t> buffer((entrada.tamanho + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+		const char* registro = reinterpret_cast<const char*>(buffer.data());
+
+		dados.seekg(static_cast<std::streamoff>(entrada.offset));
+		dados.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(entrada.tamanho));
+		if (!dados)
+			throw std::runtime_error("corpus: registro truncado em " + caminhoDados);
+
+		CabecalhoRegistroCorpus cabecalho;
+		std::memcpy(&cabecalho, registro, sizeof(cabecalho));
+		uint64_t total = cabecalho.tamanhoTotal;
+		if (!registroValido(cabecalho, entrada.offset, tamanhoArquivo) || total != entrada.tamanho
+			|| cabecalho.offsetGrafo < sizeof(cabecalho) + cabecalho.tamanhoId
+			|| !cabeNoRegistro(cabecalho.offsetGrafo, cabecalho.tamanhoGrafo, 1, total)
+			|| cabecalho.offsetGrafo % sizeof(uint64_t) != 0
+			|| !cabeNoRegistro(cabecalho.offsetDistancias, cabecalho.tamanhoSolucao, sizeof(double), total)
+			|| !cabeNoRegistro(cabecalho.offsetPredecessores, cabecalho.tamanhoSolucao, sizeof(uint64_t), total))
+			throw std::runtime_error("corpus: registro invalido para " + std::string(entrada.id));
+
+		InstanciaCorpus instancia;
+		instancia.id.assign(registro + sizeof(cabecalho), cabecalho.tamanhoId);
+		instancia.tamanho = cabecalho.tamanho;
+		instancia.densidade = cabecalho.densidade;
+
+		std::vector<size_t> iniciosConvertidos;
+		VisaoCSR<size_t, double> visao = interpretaGrafoBinario<size_t, double>(registro + cabecalho.offsetGrafo, cabecalho.tamanhoGrafo, iniciosConvertidos);
+		instancia.grafo.inicios.assign(visao.inicios.begin(), visao.inicios.end());
+		instancia.grafo.destinos.assign(visao.destinos.begin(), visao.destinos.end());
+		instancia.grafo.pesos.assign(visao.pesos.begin(), visao.pesos.end());
+
+		const double* distancias = reinterpret_cast<const double*>(registro + cabecalho.offsetDistancias);
+		const uint64_t* predecessores = reinterpret_cast<const uint64_t*>(registro + cabecalho.offsetPredecessores);
+		instancia.distancias.assign(distancias, distancias + cabecalho.tamanhoSolucao);
+		instancia.predecessores.assign(predecessores, predecessores + cabecalho.tamanhoSolucao);
+		return instancia;
+	}
+}
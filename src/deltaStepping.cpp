@@ -0,0 +1,131 @@
+#include "../headers/algoritmo.hpp"
+#include "../headers/paralelo.hpp"
+
+#include <algorithm>
+#include <barrier>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace CaminhoMinimo {
+    // Delta-stepping com posse de vértices: cada thread é dona de um bloco contíguo de ids e é a única que lê e escreve
+    // distD/predecessores desses vértices. Relaxar uma aresta vira uma requisição (vértice, origem, distância) no buffer
+    // local da thread que gerou, separado por thread dona; depois de uma barreira cada dona aplica as requisições
+    // endereçadas a ela. Assim não há atomics nem locks, só barreiras entre as fases.
+    template <typename Vertice, typename Peso>
+    void Algoritmo<Vertice, Peso>::deltaStepping(Vertice origem, Peso delta, size_t numThreads) {
+        if (!(delta > 0))
+            throw std::invalid_argument("deltaStepping: delta precisa ser positivo");
+
+        predecessores.assign(tamGrafo, NULO); // reaproveita a capacidade da busca anterior
+        numThreads = std::min(resolveThreads(numThreads), std::max<size_t>(tamGrafo, 1));
+
+        size_t tamanhoBloco = (tamGrafo + numThreads - 1) / numThreads;
+        auto dono = [&](Vertice v) { return static_cast<size_t>(v) / tamanhoBloco; };
+        auto indiceBalde = [&](Peso dist) { return static_cast<size_t>(dist / delta); };
+
+        struct Requisicao {
+            Vertice vertice;
+            Vertice origem;
+            Peso dist;
+        };
+        // requisicoes[de][para]: relaxações geradas pela thread "de" para vértices da thread "para"
+        std::vector<std::vector<std::vector<Requisicao>>> requisicoes(numThreads, std::vector<std::vector<Requisicao>>(numThreads));
+
+        constexpr size_t NENHUM = std::numeric_limits<size_t>::max();
+        std::vector<size_t> proximoBalde(numThreads, NENHUM);
+        std::vector<char> baldeAtivo(numThreads, false);
+        std::vector<Peso> distExpandida(tamGrafo, INFINITO); // distância com que o vértice teve as arestas relaxadas por último
+        std::barrier sincronizacao(static_cast<std::ptrdiff_t>(numThreads));
+
+        paraCadaThread(numThreads, [&](size_t t) {
+            // baldes[i]: vértices desta thread com distância em [i * delta, (i + 1) * delta). Entradas antigas de
+            // vértices que melhoraram ficam para trás e são puladas ao esvaziar o balde.
+            std::vector<std::vector<Vertice>> baldes;
+            std::vector<Vertice> fronteira, removidos;
+
+            auto insereBalde = [&](Vertice v) {
+                size_t i = indiceBalde(distD[v]);
+                if (i >= baldes.size()) baldes.resize(i + 1);
+                baldes[i].push_back(v);
+            };
+
+            // leves: peso <= delta, podem cair de volta no balde atual; pesadas só caem em baldes posteriores
+            auto geraRequisicoes = [&](Vertice u, bool leves) {
+                for (size_t aresta = visaoGrafo.inicios[u]; aresta < visaoGrafo.inicios[u + 1]; aresta++) {
+                    Peso peso = visaoGrafo.pesos[aresta];
+                    if ((peso <= delta) != leves) continue;
+
+                    Vertice vizinho = visaoGrafo.destinos[aresta];
+#ifdef LIMPARUIDO
+                    Peso distanciaNova = limpaRuido(distD[u] + peso);
+#else
+                    Peso distanciaNova = distD[u] + peso;
+#endif
+                    requisicoes[t][dono(vizinho)].push_back({ vizinho, u, distanciaNova });
+                }
+            };
+
+            auto aplicaRequisicoes = [&]() {
+                for (size_t de = 0; de < numThreads; de++) {
+                    for (const auto& requisicao : requisicoes[de][t]) {
+                        if (requisicao.dist < distD[requisicao.vertice]) {
+                            distD[requisicao.vertice] = requisicao.dist;
+                            predecessores[requisicao.vertice] = requisicao.origem;
+                            insereBalde(requisicao.vertice);
+                        }
+                    }
+                    requisicoes[de][t].clear();
+                }
+            };
+
+            if (dono(origem) == t) insereBalde(origem);
+
+            size_t baldeAtual = 0;
+            while (true) {
+                // 1. Menor balde não vazio entre todas as threads
+                proximoBalde[t] = NENHUM;
+                for (size_t i = baldeAtual; i < baldes.size(); i++) {
+                    if (!baldes[i].empty()) {
+                        proximoBalde[t] = i;
+                        break;
+                    }
+                }
+                sincronizacao.arrive_and_wait();
+                baldeAtual = *std::min_element(proximoBalde.begin(), proximoBalde.end());
+                if (baldeAtual == NENHUM) break;
+
+                // 2. Arestas leves até o balde atual ficar vazio em todas as threads
+                removidos.clear();
+                while (true) {
+                    fronteira.clear();
+                    if (baldeAtual < baldes.size()) fronteira.swap(baldes[baldeAtual]);
+                    for (Vertice u : fronteira) {
+                        if (indiceBalde(distD[u]) != baldeAtual || distExpandida[u] == distD[u]) continue; // entrada antiga ou repetida
+                        // u pode ser expandido de novo neste balde se melhorar, mas entra uma vez só em removidos
+                        if (distExpandida[u] == INFINITO || indiceBalde(distExpandida[u]) != baldeAtual) removidos.push_back(u);
+                        distExpandida[u] = distD[u];
+                        geraRequisicoes(u, true);
+                    }
+                    sincronizacao.arrive_and_wait();
+
+                    aplicaRequisicoes();
+                    baldeAtivo[t] = baldeAtual < baldes.size() && !baldes[baldeAtual].empty();
+                    sincronizacao.arrive_and_wait();
+
+                    if (std::none_of(baldeAtivo.begin(), baldeAtivo.end(), [](char ativo) { return ativo; })) break;
+                }
+
+                // 3. Arestas pesadas de tudo o que saiu do balde, uma vez só
+                for (Vertice u : removidos) geraRequisicoes(u, false);
+                sincronizacao.arrive_and_wait();
+                aplicaRequisicoes();
+            }
+        });
+    }
+
+#define INSTANCIA_DELTASTEPPING(V, P) \
+    template void Algoritmo<V, P>::deltaStepping(V, P, size_t);
+
+    CAMINHOMINIMO_TIPOS(INSTANCIA_DELTASTEPPING)
+}
@@ -0,0 +1,114 @@
+#include "../headers/algoritmo.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace CaminhoMinimo {
+    // Dijkstra bidirecional: uma busca sai da origem no grafo normal e outra sai do alvo no grafo reverso, sempre
+    // avançando o lado com a fila menor. melhorCaminho guarda o menor distD[v] + distReversa[v] visto até agora e a busca
+    // para quando a soma dos topos das duas filas chega nele, já que nenhum caminho ainda não visto pode ser mais curto.
+    template <typename Vertice, typename Peso>
+    void Algoritmo<Vertice, Peso>::dijkstraBidirecional(Vertice origem, Vertice alvo) {
+        predecessores.assign(tamGrafo, NULO); // reaproveita a capacidade da busca anterior
+        if (origem == alvo) return;
+
+        auto& area = areaBidirecional;
+        if (area.sucessores.size() != tamGrafo) {
+            area.distReversa.assign(tamGrafo, INFINITO);
+            area.sucessores.assign(tamGrafo, NULO);
+            area.noCaminho.assign(tamGrafo, false);
+        }
+        std::vector<Peso>& distReversa = area.distReversa;
+        std::vector<Vertice>& sucessores = area.sucessores;
+        distReversa[alvo] = 0;
+        area.tocadosReversa.push_back(alvo);
+
+        Peso melhorCaminho = INFINITO;
+        Vertice encontro = NULO;
+
+        // tocados recebe os vértices alcançados pela primeira vez (só no lado reverso, o direto usa distD inteiro)
+        auto expande = [&](HeapIndexado<Vertice, Peso>& fila, const VisaoCSR<Vertice, Peso>& grafo,
+            std::vector<Peso>& dist, const std::vector<Peso>& distOutroLado, std::vector<Vertice>& arvore, std::vector<Vertice>* tocados) {
+            Vertice verticeAtual = fila.top().second;
+            fila.pop();
+
+            for (size_t aresta = grafo.inicios[verticeAtual]; aresta < grafo.inicios[verticeAtual + 1]; aresta++) {
+                Vertice vizinho = grafo.destinos[aresta];
+#ifdef LIMPARUIDO
+                Peso distanciaNova = limpaRuido(dist[verticeAtual] + grafo.pesos[aresta]);
+#else
+                Peso distanciaNova = dist[verticeAtual] + grafo.pesos[aresta];
+#endif
+                if (distanciaNova < dist[vizinho]) {
+                    if (tocados != nullptr && dist[vizinho] == INFINITO) tocados->push_back(vizinho);
+                    dist[vizinho] = distanciaNova;
+                    arvore[vizinho] = verticeAtual;
+                    fila.push({ distanciaNova, vizinho });
+
+                    // toda melhora de um lado é comparada com o outro, então melhorCaminho nunca perde um encontro
+                    if (distanciaNova + distOutroLado[vizinho] < melhorCaminho) {
+                        melhorCaminho = distanciaNova + distOutroLado[vizinho];
+                        encontro = vizinho;
+                    }
+                }
+            }
+        };
+
+        heapIndexado.push({ Peso(0), origem });
+        heapIndexadoReverso.push({ Peso(0), alvo });
+        while (!heapIndexado.empty() && !heapIndexadoReverso.empty()
+            && heapIndexado.top().first + heapIndexadoReverso.top().first < melhorCaminho) {
+            if (heapIndexado.size() <= heapIndexadoReverso.size())
+                expande(heapIndexado, visaoGrafo, distD, distReversa, predecessores, nullptr);
+            else
+                expande(heapIndexadoReverso, visaoReversa, distReversa, distD, sucessores, &area.tocadosReversa);
+        }
+        heapIndexado.clear();
+        heapIndexadoReverso.clear();
+
+        if (encontro != NULO) emendaCaminho(encontro, alvo);
+
+        for (Vertice v : area.tocadosReversa) {
+            distReversa[v] = INFINITO;
+            sucessores[v] = NULO;
+        }
+        area.tocadosReversa.clear();
+    }
+
+    // Emenda o trecho da busca reversa (encontro -> alvo) na árvore de predecessores. Com ciclos de peso 0 esse
+    // trecho pode passar de novo por um vértice do caminho origem -> encontro; nesse caso o predecessor dele fica
+    // como está, o que só encurta o caminho.
+    // distD é refeito ao longo do trecho somando na mesma ordem que o Dijkstra, senão a distância do alvo pode
+    // diferir no último bit de ponto flutuante da que execDijkstra devolveria
+    template <typename Vertice, typename Peso>
+    void Algoritmo<Vertice, Peso>::emendaCaminho(Vertice encontro, Vertice alvo) {
+        auto& area = areaBidirecional;
+        for (Vertice v = encontro; v != NULO; v = predecessores[v]) {
+            area.noCaminho[v] = true;
+            area.caminho.push_back(v);
+        }
+        for (Vertice v = encontro; v != alvo; v = area.sucessores[v]) {
+            Vertice proximo = area.sucessores[v];
+            if (area.noCaminho[proximo]) continue;
+
+            Peso peso = INFINITO;
+            for (size_t aresta = visaoGrafo.inicios[v]; aresta < visaoGrafo.inicios[v + 1]; aresta++)
+                if (visaoGrafo.destinos[aresta] == proximo) peso = std::min(peso, visaoGrafo.pesos[aresta]);
+#ifdef LIMPARUIDO
+            distD[proximo] = limpaRuido(distD[v] + peso);
+#else
+            distD[proximo] = distD[v] + peso;
+#endif
+            predecessores[proximo] = v;
+        }
+
+        for (Vertice v : area.caminho) area.noCaminho[v] = false;
+        area.caminho.clear();
+    }
+
+#define INSTANCIA_DIJKSTRA_BIDIRECIONAL(V, P) \
+    template void Algoritmo<V, P>::dijkstraBidirecional(V, V); \
+    template void Algoritmo<V, P>::emendaCaminho(V, V);
+
+    CAMINHOMINIMO_TIPOS(INSTANCIA_DIJKSTRA_BIDIRECIONAL)
+}
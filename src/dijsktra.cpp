@@ -1,33 +1,41 @@
 #include "../headers/algoritmo.hpp"
+#include "../headers/radixHeap.hpp"
+#include "../headers/filaDial.hpp"
 
 #include <vector>
 #include <algorithm>
 
 namespace CaminhoMinimo {
-    std::vector<size_t> Algoritmo::dijkstra(size_t origem) {
-        // a distancia  salva diretamente em distD.
-        std::vector<size_t> predecessores(tamGrafo, NULO); //rot
+    // Acima disso a fila Dial gastaria mais varrendo baldes vazios do que um heap
+    constexpr double MAXBALDESDIAL = 1 << 24;
 
-        FilaPrioridade verticesParaProcessar;
-        verticesParaProcessar.push({ 0.0, origem });
+    // Dijkstra com remoo preguiosa sobre qualquer fila com a interface de FilaPrioridade (push/top/pop/empty).
+    // As origens entram com a distncia que j est em distD. Com alvos (ordenados), para quando o ltimo deles sai da fila com a distncia final.
+    template <typename Vertice, typename Peso, typename Fila>
+    static void executaDijkstra(const VisaoCSR<Vertice, Peso>& visaoGrafo, std::vector<Peso>& distD, std::vector<Vertice>& predecessores,
+        const std::vector<Vertice>& origens, Fila& verticesParaProcessar, const std::vector<Vertice>& alvos) {
+        size_t alvosRestantes = alvos.size();
+        for (Vertice origem : origens)
+            verticesParaProcessar.push({ distD[origem], origem });
 
         while (!verticesParaProcessar.empty()) {
             auto parAtual = verticesParaProcessar.top();
             verticesParaProcessar.pop();
 
-            double distancia = parAtual.first;
-            size_t verticeAtual = parAtual.second;
+            Peso distancia = parAtual.first;
+            Vertice verticeAtual = parAtual.second;
             if (distancia > distD[verticeAtual]) continue;
+            if (alvosRestantes > 0 && std::binary_search(alvos.begin(), alvos.end(), verticeAtual) && --alvosRestantes == 0) break;
 
-            for (const auto& parVizinho : ptrGrafo->at(verticeAtual)) {
-                size_t vizinho = parVizinho.first;
-                double peso = parVizinho.second;
+            for (size_t aresta = visaoGrafo.inicios[verticeAtual]; aresta < visaoGrafo.inicios[verticeAtual + 1]; aresta++) {
+                Vertice vizinho = visaoGrafo.destinos[aresta];
+                Peso peso = visaoGrafo.pesos[aresta];
 
                 // linha 14 era redundante. Pulei direto para 15.
 #ifdef LIMPARUIDO
-                double distanciaNova = limpaRuido(distD[verticeAtual] + peso);
+                Peso distanciaNova = limpaRuido(distD[verticeAtual] + peso);
 #else
-                double distanciaNova = distD[verticeAtual] + peso;
+                Peso distanciaNova = distD[verticeAtual] + peso;
 #endif
                 if (distanciaNova < distD[vizinho]) {
                     distD[vizinho] = distanciaNova;
@@ -36,6 +44,49 @@ namespace CaminhoMinimo {
                 }
             }
         }
-        return predecessores;
     }
-}
\ No newline at end of file
+
+    template <typename Vertice, typename Peso>
+    void Algoritmo<Vertice, Peso>::dijkstra(const std::vector<Vertice>& origens) {
+        // a distancia  salva diretamente em distD.
+        predecessores.assign(tamGrafo, NULO); // reaproveita a capacidade da busca anterior
+
+        // largura 1.0 para pesos inteiros; com pesos menores que 1 a largura encolhe para continuar exata.
+        // A faixa  a medida em setGrafo, ento nenhuma chave cai fora do anel. Arestas de peso 0 (inclusive as que
+        // ligam as cpias da transformao de grau constante) zeram a largura e a busca vai para o Radix
+        Peso pesoMinimo = grafoCompartilhado->pesoMinimo, pesoMaximo = grafoCompartilhado->pesoMaximo;
+        Peso larguraDial = std::min<Peso>(1, pesoMinimo);
+        bool usaDial = filaDijkstra == FilaDijkstra::Dial && larguraDial > 0 && pesoMaximo / larguraDial <= MAXBALDESDIAL;
+
+        // com vrias origens o anel comea no menor deslocamento e todos eles precisam caber numa volta dele
+        Peso menorInicio = INFINITO, maiorInicio = 0;
+        for (Vertice origem : origens) {
+            menorInicio = std::min(menorInicio, distD[origem]);
+            maiorInicio = std::max(maiorInicio, distD[origem]);
+        }
+        if (origens.empty()) menorInicio = 0;
+        usaDial = usaDial && maiorInicio - menorInicio <= pesoMaximo;
+
+        if (usaDial) {
+            FilaDial<Vertice, Peso> verticesParaProcessar(larguraDial, pesoMaximo, menorInicio);
+            executaDijkstra(visaoGrafo, distD, predecessores, origens, verticesParaProcessar, alvosConsulta);
+        }
+        else if (filaDijkstra == FilaDijkstra::Radix || filaDijkstra == FilaDijkstra::Dial) { // Dial sem faixa utilizvel cai aqui
+            RadixHeap<Vertice, Peso> verticesParaProcessar;
+            executaDijkstra(visaoGrafo, distD, predecessores, origens, verticesParaProcessar, alvosConsulta);
+        }
+        else if (filaDijkstra == FilaDijkstra::Binaria) {
+            FilaPrioridade<Vertice, Peso> verticesParaProcessar;
+            executaDijkstra(visaoGrafo, distD, predecessores, origens, verticesParaProcessar, alvosConsulta);
+        }
+        else {
+            executaDijkstra(visaoGrafo, distD, predecessores, origens, heapIndexado, alvosConsulta);
+            heapIndexado.clear(); // sobra o que estava na fila quando a consulta parou cedo
+        }
+    }
+
+#define INSTANCIA_DIJKSTRA(V, P) \
+    template void Algoritmo<V, P>::dijkstra(const std::vector<V>&);
+
+    CAMINHOMINIMO_TIPOS(INSTANCIA_DIJKSTRA)
+}
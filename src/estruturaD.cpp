@@ -12,10 +12,26 @@
 #include <cassert>
 #include <algorithm>
 #include <queue>
+#include <cstdint>
 
 
 // Construtor
-D::D(size_t M, double B) : tamLoteM(M), limiteSuperiorB(B) {
+template <typename Vertice, typename Peso>
+D<Vertice, Peso>::D(size_t M, Peso B) {
+    reinicia(M, B);
+}
+
+// Esvazia D e recomeça com novos M e B. O bmssp guarda um D por nível e chama isto a cada chamada do nível
+template <typename Vertice, typename Peso>
+void D<Vertice, Peso>::reinicia(size_t M, Peso B) {
+    tamLoteM = M;
+    limiteSuperiorB = B;
+    blocosD_0.clear();
+    blocosD_1.clear();
+    limites.clear();
+    status.clear(); // clear mantém os buckets
+    menores.clear();
+
     // Inicializa D_1 com um bloco vazio e com limite B
     blocosD_1.push_back(Bloco());
     const auto& i = blocosD_1.begin();
@@ -24,7 +40,8 @@ D::D(size_t M, double B) : tamLoteM(M), limiteSuperiorB(B) {
 
 // Insert a key/value pair in amortized O(max{1, log(N/M)}) time. 
 // If the key already exists, update its value.
-void D::insert(size_t vertice, double distancia) {
+template <typename Vertice, typename Peso>
+void D<Vertice, Peso>::insert(Vertice vertice, Peso distancia) {
     auto iStatus = status.find(vertice);
 
     // Se achar o vertice e se nova distância é pior ou igual, ignora
@@ -48,13 +65,15 @@ void D::insert(size_t vertice, double distancia) {
 #else
     status.insert_or_assign(vertice, distancia);
 #endif
+    registraChave(vertice, distancia);
     // Se o bloco estourou o tamanho M, divide ele
     if (iLimites->second->size() > tamLoteM) dividir(iLimites);
 }
 
 // Esta função é chamada internamente por D::batchPrepend
 // Processa o range [inicio, fim) do vetor 'lotes'
-void D::dividirLote(std::vector<ParDistVertice>& lotes, size_t inicio, size_t fim) {
+template <typename Vertice, typename Peso>
+void D<Vertice, Peso>::dividirLote(std::vector<ParDistVertice>& lotes, size_t inicio, size_t fim) {
     size_t tamanho = fim - inicio;
 
     // A. Condição de Parada (O(M log M))
@@ -79,6 +98,7 @@ void D::dividirLote(std::vector<ParDistVertice>& lotes, size_t inicio, size_t fi
                     false         // pertenceD1 é FALSE (está em D0)
                 }
             );
+            registraChave(iElem->second, iElem->first);
         }
 #endif
         return;
@@ -104,55 +124,40 @@ void D::dividirLote(std::vector<ParDistVertice>& lotes, size_t inicio, size_t fi
 }
 
 // BATCH PREPEND: Insere lote urgente
-void D::batchPrepend(std::vector<ParDistVertice>& loteL) {
-    std::unordered_map<size_t, double> loteFiltrado;
-    std::vector<size_t> paraRemoverDoStatus;
-
-    // 1. Filtra o melhor dentro do lote (resolve duplicatas no input)
-    for (auto& [distancia, vertice] : loteL) {
-        auto iLote = loteFiltrado.find(vertice);
-        if (iLote == loteFiltrado.end() || distancia < loteFiltrado[vertice]) {
-            loteFiltrado[vertice] = distancia;
-        }
-    }
-
-    // 2. Compara com status global e marca remoções
-    auto it = loteFiltrado.begin();
-    while (it != loteFiltrado.end()) {
-        size_t vertice = it->first;
-        double distancia = it->second;
-
+template <typename Vertice, typename Peso>
+void D<Vertice, Peso>::batchPrepend(std::vector<ParDistVertice>& loteL) {
+    // 1. Filtra o melhor dentro do lote (resolve duplicatas no input): ordena por vértice e, no empate, por distância e
+    // fica com o primeiro de cada vértice. Ordenar o próprio lote evita montar um unordered_map (um nó alocado por item)
+    // a cada chamada, que era a maior parte do último passo da etapa Retorno perto da raiz
+    std::sort(loteL.begin(), loteL.end(), [](const ParDistVertice& a, const ParDistVertice& b) {
+        return a.second < b.second || (a.second == b.second && a.first < b.first);
+    });
+    loteL.erase(std::unique(loteL.begin(), loteL.end(), [](const ParDistVertice& a, const ParDistVertice& b) {
+        return a.second == b.second;
+    }), loteL.end());
+
+    // 2. Compara com status global: descarta o que não melhora e remove de D a versão antiga do que melhora
+    size_t fimFiltrado = 0;
+    for (size_t i = 0; i < loteL.size(); i++) {
+        auto [distancia, vertice] = loteL[i];
         auto iStatus = status.find(vertice);
         if (iStatus != status.end()) {
 #ifdef O1
-
-            double distanciaAntiga = iStatus->second.iElem->first;
+            Peso distanciaAntiga = iStatus->second.iElem->first;
 #else
-            double distanciaAntiga = iStatus->second;  
+            Peso distanciaAntiga = iStatus->second;
 #endif
             // Se o caminho novo for pior ou igual, descartamos do lote
-            if (distancia >= distanciaAntiga) {
-                it = loteFiltrado.erase(it);
-                continue;
-            }
-            else {
-                // Se o caminho novo for melhor, removemos o antigo da estrutura D
-                paraRemoverDoStatus.push_back(vertice);
-            }
+            if (distancia >= distanciaAntiga) continue;
+            // Se o caminho novo for melhor, removemos o antigo da estrutura D (garante consistência)
+            removeChave(vertice);
         }
-        ++it;
+        loteL[fimFiltrado++] = loteL[i];
     }
+    loteL.resize(fimFiltrado);
 
-    // Remove as versões antigas de D (garante consistência)
-    for (size_t v : paraRemoverDoStatus) removeChave(v);
-
-    // 3. Copia para vetor e ORDENA
-    std::vector<ParDistVertice> aux;
-    aux.reserve(loteFiltrado.size());
-    for (auto& [vertice, distancia] : loteFiltrado) {
-        aux.push_back({ distancia, vertice });
-        //status.insert_or_assign(vertice, Status(distancia)); // Atualiza status global
-    }
+    // 3. O próprio lote, já filtrado, é ordenado e dividido em blocos
+    std::vector<ParDistVertice>& aux = loteL;
 
 #ifdef RANGE
     struct Range { size_t inicio, fim; };
@@ -191,6 +196,7 @@ void D::batchPrepend(std::vector<ParDistVertice>& loteL) {
 #else
                 status.insert_or_assign(iElem->second, iElem->first);
 #endif
+                registraChave(iElem->second, iElem->first);
             }
         }
         else
@@ -224,6 +230,7 @@ void D::batchPrepend(std::vector<ParDistVertice>& loteL) {
 #else
             status.insert_or_assign(iElem->second, iElem->first);
 #endif
+            registraChave(iElem->second, iElem->first);
         }
     }
     else {
@@ -247,84 +254,121 @@ void D::batchPrepend(std::vector<ParDistVertice>& loteL) {
 #else
                 status.insert_or_assign(iElem->second, iElem->first);
 #endif
+                registraChave(iElem->second, iElem->first);
             }
         }
     }
 #endif
 }
 
-std::pair<double, std::vector<ParDistVertice>> D::pull() {
-    std::vector<ParDistVertice> candidatosD_0;
-    std::vector<ParDistVertice> candidatosD_1;
-    std::vector<ParDistVertice> candidatosTotais;
+// Os pares puxados vão para loteSi, que é de quem chama e só é limpo aqui, para o BMSSP reaproveitar o mesmo vetor
+// em todos os pulls em vez de receber um vetor novo a cada um
+template <typename Vertice, typename Peso>
+Peso D<Vertice, Peso>::pull(std::vector<ParDistVertice>& loteSi) {
+    // loteSi começa como a lista de candidatos e depois é cortado para os M menores
+    loteSi.clear();
 
     // Coleta sempre um a mais para saber se há excedente
     size_t limiteVerificacao = tamLoteM + 1;
 
     // 1. Coleta de D_0
+    size_t blocosPercorridosD_0 = 0;
     for (auto& bloco : blocosD_0) {
-        for (auto& par : bloco) {
-            candidatosD_0.push_back(par);
-            //if (candidatosD_0.size() >= limiteVerificacao) break;
-        }
-        if (candidatosD_0.size() >= limiteVerificacao) break;
+        loteSi.insert(loteSi.end(), bloco.begin(), bloco.end());
+        blocosPercorridosD_0++;
+        if (loteSi.size() >= limiteVerificacao) break;
     }
 
-    // 2. Coleta de D_1
+    // 2. Coleta de D_1 (o limite vale para cada lado separadamente)
+    size_t inicioD_1 = loteSi.size();
+    size_t blocosPercorridosD_1 = 0;
     for (auto& bloco : limites) {
-        for (auto& par : *(bloco.second)) {
-            candidatosD_1.push_back(par);
-            //if (candidatosD_1.size() >= limiteVerificacao) break;
-        }
-        if (candidatosD_1.size() >= limiteVerificacao) break;
+        loteSi.insert(loteSi.end(), bloco.second->begin(), bloco.second->end());
+        blocosPercorridosD_1++;
+        if (loteSi.size() - inicioD_1 >= limiteVerificacao) break;
     }
 
-    candidatosTotais.insert(candidatosTotais.end(), candidatosD_0.begin(), candidatosD_0.end());
-    candidatosTotais.insert(candidatosTotais.end(), candidatosD_1.begin(), candidatosD_1.end());
-
-    double novoLimiteBi;
-    std::vector<ParDistVertice> loteDeRetornoSi;
+    Peso novoLimiteBi;
 
     // 3. Lógica Unificada: Sempre particiona e remove individualmente
-    if (candidatosTotais.empty()) {
-        return std::make_pair(limiteSuperiorB, std::vector<ParDistVertice>{});
+    if (loteSi.empty()) {
+        return limiteSuperiorB;
     }
 
-    if (candidatosTotais.size() <= tamLoteM) {
+    if (loteSi.size() <= tamLoteM) {
         // Caso A: Temos menos ou igual a M elementos. Retornamos TUDO o que achamos.
         // O limite vira o limite superior da estrutura, pois esgotamos os candidatos visíveis
         novoLimiteBi = limiteSuperiorB;
-        loteDeRetornoSi = candidatosTotais;
     }
     else {
         // Caso B: Temos mais que M. Pegamos apenas os M melhores.
-        std::nth_element(candidatosTotais.begin(), candidatosTotais.begin() + tamLoteM, candidatosTotais.end());
+        std::nth_element(loteSi.begin(), loteSi.begin() + tamLoteM, loteSi.end());
 
-        novoLimiteBi = candidatosTotais[tamLoteM].first;
+        novoLimiteBi = loteSi[tamLoteM].first;
 
         // Tratamento de empate
-        double maxSi = candidatosTotais[0].first;
+        Peso maxSi = loteSi[0].first;
         for (size_t k = 1; k < tamLoteM; ++k) {
-            if (candidatosTotais[k].first > maxSi) maxSi = candidatosTotais[k].first;
+            if (loteSi[k].first > maxSi) maxSi = loteSi[k].first;
         }
-        if (novoLimiteBi <= maxSi) novoLimiteBi = maxSi + 1e-9;
+        // 1e-9 some quando Peso é float, então usamos o próximo valor representável acima de maxSi
+        if (novoLimiteBi <= maxSi) novoLimiteBi = std::max<Peso>(maxSi + static_cast<Peso>(1e-9), std::nextafter(maxSi, std::numeric_limits<Peso>::infinity()));
 
-        loteDeRetornoSi.reserve(tamLoteM);
-        for (size_t i = 0; i < tamLoteM; i++) {
-            loteDeRetornoSi.push_back(candidatosTotais[i]);
-        }
+        loteSi.resize(tamLoteM);
     }
 
     // 4. REMOÇÃO SEGURA: Removemos APENAS os itens que vamos retornar.
-    for (auto& par : loteDeRetornoSi) {
+#ifdef O1
+    for (auto& par : loteSi) {
         removeChave(par.second);
     }
+#else
+    // Sem O1, removeChave procura cada chave no bloco de D_1 da distância dela e depois em todo D_0: com M = 1024 perto
+    // da raiz isso era um pull de vários ms. Os itens devolvidos vieram dos blocos que acabamos de percorrer e cada
+    // vértice está em D uma vez só, então basta tirá-los do status e filtrar esses blocos, O(itens coletados)
+    for (auto& par : loteSi) status.erase(par.second);
+    auto foiPuxado = [&](const ParDistVertice& par) { return status.find(par.second) == status.end(); };
+
+    auto iBlocoD_0 = blocosD_0.begin();
+    for (size_t b = 0; b < blocosPercorridosD_0; b++) {
+        iBlocoD_0->remove_if(foiPuxado);
+        iBlocoD_0 = iBlocoD_0->empty() ? blocosD_0.erase(iBlocoD_0) : std::next(iBlocoD_0);
+    }
+    auto iLimites = limites.begin();
+    for (size_t b = 0; b < blocosPercorridosD_1; b++) {
+        iLimites->second->remove_if(foiPuxado);
+        if (iLimites->second->empty() && iLimites->first != limiteSuperiorB) {
+            blocosD_1.erase(iLimites->second);
+            iLimites = limites.erase(iLimites);
+        }
+        else ++iLimites;
+    }
+#endif
+
+    return novoLimiteBi;
+}
 
-    return std::make_pair(novoLimiteBi, loteDeRetornoSi);
+// Menor chave guardada em D (B se estiver vazia). Descarta do topo de 'menores' as entradas de chaves que já saíram
+// ou foram trocadas por uma menor; cada entrada é descartada uma vez só
+template <typename Vertice, typename Peso>
+Peso D<Vertice, Peso>::menorChave() const {
+    while (!menores.empty()) {
+        auto [distancia, vertice] = menores.front();
+        auto iStatus = status.find(vertice);
+#ifdef O1
+        if (iStatus != status.end() && iStatus->second.distancia == distancia) return distancia;
+#else
+        if (iStatus != status.end() && iStatus->second == distancia) return distancia;
+#endif
+        std::pop_heap(menores.begin(), menores.end(), std::greater<ParDistVertice>());
+        menores.pop_back();
+    }
+    return limiteSuperiorB;
 }
 
 // REMOVE CHAVE
-void D::removeChave(size_t vertice) {
+template <typename Vertice, typename Peso>
+void D<Vertice, Peso>::removeChave(Vertice vertice) {
     auto iStatus = status.find(vertice);
     if (iStatus == status.end()) return;
 
@@ -367,7 +411,7 @@ void D::removeChave(size_t vertice) {
 
      //4. Remoção do Status (O(1) em Média)
  
-    double distancia = iStatus->second;
+    Peso distancia = iStatus->second;
 
     // 1. Tenta remover de D_1
     auto iLimites = limites.lower_bound(distancia);
@@ -427,8 +471,9 @@ void D::removeChave(size_t vertice) {
 }
 
 // DIVIDIR
-void D::dividir(std::map<double, std::list<Bloco>::iterator>::iterator& iLimites) {
-    double limiteAntigo = iLimites->first;
+template <typename Vertice, typename Peso>
+void D<Vertice, Peso>::dividir(typename MapaLimites::iterator& iLimites) {
+    Peso limiteAntigo = iLimites->first;
     auto iBloco = iLimites->second;
 
     std::vector<ParDistVertice> aux(iBloco->begin(), iBloco->end());
@@ -438,7 +483,7 @@ void D::dividir(std::map<double, std::list<Bloco>::iterator>::iterator& iLimites
     // elements smaller than the median are placed in the first block, while the rest 
     // are placed in the second.
     std::nth_element(aux.begin(), aux.begin() + tamLoteM / 2, aux.end());
-    double valorMediana = aux[tamLoteM / 2].first;
+    Peso valorMediana = aux[tamLoteM / 2].first;
 
     // Criamos APENAS o bloco 2 para onde moveremos os elementos MAIORES
     Bloco bloco2;
@@ -459,7 +504,7 @@ void D::dividir(std::map<double, std::list<Bloco>::iterator>::iterator& iLimites
 
     for (auto iElem = iBloco2->begin(); iElem != iBloco2->end(); ++iElem) {
         // O vértice é o segundo elemento do ParDistVertice
-        size_t vertice = iElem->second;
+        Vertice vertice = iElem->second;
 
         // Atualiza a localização do bloco em O(1) médio
         // Note que pertenceD1 já é TRUE aqui.
@@ -468,7 +513,7 @@ void D::dividir(std::map<double, std::list<Bloco>::iterator>::iterator& iLimites
 #endif
     }
 
-    double maxBloco1 = valorMediana;
+    Peso maxBloco1 = valorMediana;
 
     // 1. Apaga o limite antigo. Isto é O(log N) ou O(1) se usar o iterador.
     // O iterador iLimites não é mais válido após o erase.
@@ -476,4 +521,10 @@ void D::dividir(std::map<double, std::list<Bloco>::iterator>::iterator& iLimites
 
     limites.insert(next_it, { maxBloco1, iBloco });
     limites.insert(next_it, { limiteAntigo, iBloco2 });
-}
\ No newline at end of file
+}
+
+template class D<size_t, double>;
+template class D<uint32_t, float>;
+#if SIZE_MAX > UINT32_MAX
+template class D<uint32_t, double>;
+#endif
@@ -0,0 +1,174 @@
+#include "../headers/geradores.hpp"
+#include "../headers/carregaGrafo.hpp"
+#include "../headers/paralelo.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace CaminhoMinimo {
+	// Motor compartilhado pelos geradores, do qual saem as sementes de cada thread (como em geraGrafo)
+	static std::mt19937& motorGeradores()
+	{
+		static std::random_device semente;
+		static std::mt19937 motor(semente());
+		return motor;
+	}
+
+	// O maior valor de Vertice fica reservado para NULO
+	template <typename Vertice>
+	static void verificaTamanho(size_t tamanho, const char* gerador)
+	{
+		if (tamanho >= static_cast<size_t>(std::numeric_limits<Vertice>::max()))
+			throw std::length_error(std::string(gerador) + ": grafo grande demais para o tipo de vertice escolhido");
+	}
+
+	template <typename Vertice, typename Peso>
+	GrafoCSR<Vertice, Peso> geraGrafoEsparso(size_t tamanho, double grauMedio, size_t numThreads)
+	{
+		verificaTamanho<Vertice>(tamanho, "geraGrafoEsparso");
+		numThreads = std::min(resolveThreads(numThreads), std::max<size_t>(tamanho, 1));
+		std::vector<std::vector<Aresta<Vertice, Peso>>> listasArestas(numThreads);
+		if (tamanho < 2) return constroiCSR<Vertice, Peso>(tamanho, listasArestas, numThreads);
+
+		double probabilidade = std::min(grauMedio / static_cast<double>(tamanho - 1), 1.0);
+		auto sementes = sorteiaSementes(motorGeradores(), numThreads);
+		size_t tamFaixa = (tamanho + numThreads - 1) / numThreads;
+
+		paraCadaThread(numThreads, [&](size_t t) {
+			std::seed_seq sementeThread{ sementes[2 * t], sementes[2 * t + 1] };
+			std::mt19937_64 motor(sementeThread);
+			std::binomial_distribution<size_t> escolheGrau(tamanho - 1, probabilidade);
+			std::uniform_int_distribution<size_t> escolheVertice(0, tamanho - 1);
+			std::uniform_real_distribution<double> escolhePeso(1.0, PESOMAX);
+
+			size_t primeira = std::min(t * tamFaixa, tamanho);
+			size_t ultima = std::min(primeira + tamFaixa, tamanho);
+			auto& arestas = listasArestas[t];
+			arestas.reserve(static_cast<size_t>(static_cast<double>(ultima - primeira) * grauMedio * 1.05));
+
+			auto porDestino = [](const Aresta<Vertice, Peso>& a, const Aresta<Vertice, Peso>& b) { return a.destino < b.destino; };
+			auto mesmoDestino = [](const Aresta<Vertice, Peso>& a, const Aresta<Vertice, Peso>& b) { return a.destino == b.destino; };
+
+			for (size_t origem = primeira; origem < ultima; origem++) {
+				size_t grau = escolheGrau(motor);
+				size_t inicioOrigem = arestas.size();
+				// Sorteia os destinos que faltam e descarta os repetidos com sort + unique, O(grau log grau) por origem.
+				// Uma marca por vértice custaria O(n) de memória por thread, demais para 10^8 vértices
+				while (arestas.size() - inicioOrigem < grau) {
+					while (arestas.size() - inicioOrigem < grau) {
+						size_t chegada = escolheVertice(motor);
+						if (chegada == origem) continue;
+						arestas.push_back({ static_cast<Vertice>(origem), static_cast<Vertice>(chegada), static_cast<Peso>(escolhePeso(motor)) });
+					}
+					auto inicio = arestas.begin() + static_cast<std::ptrdiff_t>(inicioOrigem);
+					std::sort(inicio, arestas.end(), porDestino);
+					arestas.erase(std::unique(inicio, arestas.end(), mesmoDestino), arestas.end());
+				}
+			}
+		});
+
+		return constroiCSR<Vertice, Peso>(tamanho, listasArestas, numThreads);
+	}
+
+	template <typename Vertice, typename Peso>
+	GrafoCSR<Vertice, Peso> geraGrafoGrade(size_t linhas, size_t colunas, size_t numThreads)
+	{
+		size_t tamanho = linhas * colunas;
+		verificaTamanho<Vertice>(tamanho, "geraGrafoGrade");
+		numThreads = std::min(resolveThreads(numThreads), std::max<size_t>(linhas, 1));
+		std::vector<std::vector<Aresta<Vertice, Peso>>> listasArestas(numThreads);
+		auto sementes = sorteiaSementes(motorGeradores(), numThreads);
+		size_t linhasPorThread = (linhas + numThreads - 1) / numThreads;
+
+		paraCadaThread(numThreads, [&](size_t t) {
+			std::seed_seq sementeThread{ sementes[2 * t], sementes[2 * t + 1] };
+			std::mt19937_64 motor(sementeThread);
+			std::uniform_real_distribution<double> escolhePeso(1.0, PESOMAX);
+
+			size_t primeira = std::min(t * linhasPorThread, linhas);
+			size_t ultima = std::min(primeira + linhasPorThread, linhas);
+			auto& arestas = listasArestas[t];
+			arestas.reserve((ultima - primeira) * colunas * 4);
+
+			auto adiciona = [&](size_t origem, size_t destino) {
+				arestas.push_back({ static_cast<Vertice>(origem), static_cast<Vertice>(destino), static_cast<Peso>(escolhePeso(motor)) });
+			};
+			for (size_t i = primeira; i < ultima; i++) {
+				for (size_t j = 0; j < colunas; j++) {
+					size_t vertice = i * colunas + j;
+					if (i > 0) adiciona(vertice, vertice - colunas);
+					if (i + 1 < linhas) adiciona(vertice, vertice + colunas);
+					if (j > 0) adiciona(vertice, vertice - 1);
+					if (j + 1 < colunas) adiciona(vertice, vertice + 1);
+				}
+			}
+		});
+
+		return constroiCSR<Vertice, Peso>(tamanho, listasArestas, numThreads);
+	}
+
+	template <typename Vertice, typename Peso>
+	GrafoCSR<Vertice, Peso> geraGrafoRMAT(size_t escala, double grauMedio, size_t numThreads, double a, double b, double c)
+	{
+		if (escala >= sizeof(size_t) * 8 - 1)
+			throw std::length_error("geraGrafoRMAT: escala grande demais");
+		if (a < 0 || b < 0 || c < 0 || a + b + c > 1.0)
+			throw std::invalid_argument("geraGrafoRMAT: probabilidades invalidas");
+
+		size_t tamanho = size_t(1) << escala;
+		verificaTamanho<Vertice>(tamanho, "geraGrafoRMAT");
+		size_t numArestas = static_cast<size_t>(grauMedio * static_cast<double>(tamanho));
+		numThreads = resolveThreads(numThreads);
+		auto sementes = sorteiaSementes(motorGeradores(), numThreads + 1);
+
+		// Permutação aleatória dos ids (como no Graph500)
+		std::vector<Vertice> permutacao(tamanho);
+		std::iota(permutacao.begin(), permutacao.end(), Vertice(0));
+		{
+			std::seed_seq sementePermutacao{ sementes[2 * numThreads], sementes[2 * numThreads + 1] };
+			std::mt19937_64 motor(sementePermutacao);
+			std::shuffle(permutacao.begin(), permutacao.end(), motor);
+		}
+
+		std::vector<std::vector<Aresta<Vertice, Peso>>> listasArestas(numThreads);
+		paraCadaThread(numThreads, [&](size_t t) {
+			std::seed_seq sementeThread{ sementes[2 * t], sementes[2 * t + 1] };
+			std::mt19937_64 motor(sementeThread);
+			std::uniform_real_distribution<double> sorteio(0.0, 1.0);
+			std::uniform_real_distribution<double> escolhePeso(1.0, PESOMAX);
+
+			size_t quantidade = numArestas / numThreads + (t < numArestas % numThreads ? 1 : 0);
+			auto& arestas = listasArestas[t];
+			arestas.reserve(quantidade);
+
+			for (size_t k = 0; k < quantidade; k++) {
+				// desce escala níveis na matriz de adjacência escolhendo um dos quatro quadrantes
+				size_t origem = 0, destino = 0;
+				for (size_t nivel = 0; nivel < escala; nivel++) {
+					double r = sorteio(motor);
+					origem <<= 1;
+					destino <<= 1;
+					if (r < a) {}
+					else if (r < a + b) destino |= 1;
+					else if (r < a + b + c) origem |= 1;
+					else { origem |= 1; destino |= 1; }
+				}
+				if (origem == destino) continue;
+				arestas.push_back({ permutacao[origem], permutacao[destino], static_cast<Peso>(escolhePeso(motor)) });
+			}
+		});
+
+		return constroiCSR<Vertice, Peso>(tamanho, listasArestas, numThreads);
+	}
+
+#define INSTANCIA_GERADORES(V, P) \
+	template GrafoCSR<V, P> geraGrafoEsparso<V, P>(size_t, double, size_t); \
+	template GrafoCSR<V, P> geraGrafoGrade<V, P>(size_t, size_t, size_t); \
+	template GrafoCSR<V, P> geraGrafoRMAT<V, P>(size_t, double, size_t, double, double, double);
+
+	CAMINHOMINIMO_TIPOS(INSTANCIA_GERADORES)
+}
@@ -0,0 +1,144 @@
+#include "../headers/grafoBinario.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace CaminhoMinimo {
+	static const char MAGICA_GRAFO_BINARIO[8] = "BMSSPGR";
+
+	// Confere que a seção [offset, offset + quantidade * largura) está alinhada e cabe em total, sem estourar uint64
+	static void validaSecao(uint64_t offset, uint64_t quantidade, uint64_t largura, uint64_t total, const char* nome)
+	{
+		if (offset % largura != 0)
+			throw std::runtime_error(std::string("grafo binario: secao de ") + nome + " desalinhada");
+		if (offset < sizeof(CabecalhoGrafoBinario) || offset > total || quantidade > (total - offset) / largura)
+			throw std::runtime_error(std::string("grafo binario: secao de ") + nome + " fora do arquivo");
+	}
+
+	template <typename Vertice, typename Peso>
+	static CabecalhoGrafoBinario montaCabecalho(const VisaoCSR<Vertice, Peso>& grafo)
+	{
+		CabecalhoGrafoBinario cabecalho{};
+		std::memcpy(cabecalho.magica, MAGICA_GRAFO_BINARIO, sizeof(cabecalho.magica));
+		cabecalho.versao = VERSAO_GRAFO_BINARIO;
+		cabecalho.marcaEndian = MARCA_ENDIAN;
+		cabecalho.bytesVertice = sizeof(Vertice);
+		cabecalho.bytesPeso = sizeof(Peso);
+		cabecalho.numVertices = grafo.tamanho();
+		cabecalho.numArestas = grafo.numArestas();
+
+		cabecalho.offsetInicios = alinha(sizeof(CabecalhoGrafoBinario));
+		cabecalho.offsetDestinos = alinha(cabecalho.offsetInicios + grafo.inicios.size() * sizeof(uint64_t));
+		cabecalho.offsetPesos = alinha(cabecalho.offsetDestinos + grafo.destinos.size_bytes());
+		cabecalho.tamanhoTotal = alinha(cabecalho.offsetPesos + grafo.pesos.size_bytes());
+		return cabecalho;
+	}
+
+	template <typename Vertice, typename Peso>
+	uint64_t tamanhoGrafoBinario(const VisaoCSR<Vertice, Peso>& grafo)
+	{
+		return montaCabecalho(grafo).tamanhoTotal;
+	}
+
+	template <typename Vertice, typename Peso>
+	uint64_t escreveGrafoBinario(std::ostream& saida, const VisaoCSR<Vertice, Peso>& grafo)
+	{
+		CabecalhoGrafoBinario cabecalho = montaCabecalho(grafo);
+		saida.write(reinterpret_cast<const char*>(&cabecalho), sizeof(cabecalho));
+		completaComZeros(saida, cabecalho.offsetInicios - sizeof(cabecalho));
+
+		escreveComoUint64(saida, grafo.inicios);
+		completaComZeros(saida, cabecalho.offsetDestinos - cabecalho.offsetInicios - grafo.inicios.size() * sizeof(uint64_t));
+
+		saida.write(reinterpret_cast<const char*>(grafo.destinos.data()), static_cast<std::streamsize>(grafo.destinos.size_bytes()));
+		completaComZeros(saida, cabecalho.offsetPesos - cabecalho.offsetDestinos - grafo.destinos.size_bytes());
+
+		saida.write(reinterpret_cast<const char*>(grafo.pesos.data()), static_cast<std::streamsize>(grafo.pesos.size_bytes()));
+		completaComZeros(saida, cabecalho.tamanhoTotal - cabecalho.offsetPesos - grafo.pesos.size_bytes());
+
+		return cabecalho.tamanhoTotal;
+	}
+
+	template <typename Vertice, typename Peso>
+	VisaoCSR<Vertice, Peso> interpretaGrafoBinario(const char* dados, size_t tamanho, std::vector<size_t>& iniciosConvertidos)
+	{
+		if (dados == nullptr || tamanho < sizeof(CabecalhoGrafoBinario))
+			throw std::runtime_error("grafo binario: arquivo menor que o cabecalho");
+
+		// o cabeçalho fica no início de uma região alinhada, então pode ser lido no lugar
+		const auto* cabecalho = reinterpret_cast<const CabecalhoGrafoBinario*>(dados);
+		if (std::memcmp(cabecalho->magica, MAGICA_GRAFO_BINARIO, sizeof(cabecalho->magica)) != 0)
+			throw std::runtime_error("grafo binario: assinatura invalida");
+		if (cabecalho->marcaEndian != MARCA_ENDIAN)
+			throw std::runtime_error("grafo binario: ordem de bytes diferente da maquina atual");
+		if (cabecalho->versao != VERSAO_GRAFO_BINARIO)
+			throw std::runtime_error("grafo binario: versao " + std::to_string(cabecalho->versao) + " nao suportada");
+		if (cabecalho->bytesVertice != sizeof(Vertice) || cabecalho->bytesPeso != sizeof(Peso))
+			throw std::runtime_error("grafo binario: larguras de vertice/peso diferentes das pedidas");
+
+		uint64_t n = cabecalho->numVertices;
+		uint64_t m = cabecalho->numArestas;
+		if (cabecalho->tamanhoTotal > tamanho)
+			throw std::runtime_error("grafo binario: arquivo truncado");
+		// n + 1 inícios precisam caber no arquivo e todo id precisa caber em Vertice sem virar NULO
+		if (n >= cabecalho->tamanhoTotal / sizeof(uint64_t) || n >= std::numeric_limits<Vertice>::max())
+			throw std::runtime_error("grafo binario: numero de vertices invalido");
+		validaSecao(cabecalho->offsetInicios, n + 1, sizeof(uint64_t), cabecalho->tamanhoTotal, "inicios");
+		validaSecao(cabecalho->offsetDestinos, m, sizeof(Vertice), cabecalho->tamanhoTotal, "destinos");
+		validaSecao(cabecalho->offsetPesos, m, sizeof(Peso), cabecalho->tamanhoTotal, "pesos");
+		if (reinterpret_cast<uintptr_t>(dados) % alignof(uint64_t) != 0)
+			throw std::runtime_error("grafo binario: imagem desalinhada na memoria");
+
+		VisaoCSR<Vertice, Peso> visao;
+		const uint64_t* inicios = reinterpret_cast<const uint64_t*>(dados + cabecalho->offsetInicios);
+		if constexpr (sizeof(size_t) == sizeof(uint64_t)) {
+			visao.inicios = { reinterpret_cast<const size_t*>(inicios), static_cast<size_t>(n + 1) };
+		} else {
+			// m cabe em size_t porque as arestas cabem em 'tamanho'; um início maior que m truncaria sem aviso
+			iniciosConvertidos.resize(static_cast<size_t>(n + 1));
+			for (size_t v = 0; v <= n; v++) {
+				if (inicios[v] > m)
+					throw std::runtime_error("grafo binario: inicio fora do intervalo de arestas");
+				iniciosConvertidos[v] = static_cast<size_t>(inicios[v]);
+			}
+			visao.inicios = iniciosConvertidos;
+		}
+		visao.destinos = { reinterpret_cast<const Vertice*>(dados + cabecalho->offsetDestinos), static_cast<size_t>(m) };
+		visao.pesos = { reinterpret_cast<const Peso*>(dados + cabecalho->offsetPesos), static_cast<size_t>(m) };
+
+		// Os algoritmos indexam sem conferir, então um arquivo com offsets errados leria fora da memória mapeada.
+		// Isso percorre inicios e destinos uma vez (e traz as páginas deles para a memória).
+		if (visao.inicios.front() != 0 || visao.inicios.back() != m)
+			throw std::runtime_error("grafo binario: vetor de inicios inconsistente");
+		for (size_t v = 0; v < n; v++)
+			if (visao.inicios[v] > visao.inicios[v + 1])
+				throw std::runtime_error("grafo binario: vetor de inicios nao e crescente");
+		for (Vertice destino : visao.destinos)
+			if (static_cast<uint64_t>(destino) >= n)
+				throw std::runtime_error("grafo binario: destino fora do intervalo de vertices");
+
+		return visao;
+	}
+
+	template <typename Vertice, typename Peso>
+	void salvaGrafoBinario(const VisaoCSR<Vertice, Peso>& grafo, const std::string& caminho)
+	{
+		std::ofstream arquivo(caminho, std::ios::binary | std::ios::trunc);
+		if (!arquivo.is_open())
+			throw std::runtime_error("grafo binario: nao foi possivel criar " + caminho);
+
+		escreveGrafoBinario(arquivo, grafo);
+		if (!arquivo)
+			throw std::runtime_error("grafo binario: falha ao escrever " + caminho);
+	}
+
+#define INSTANCIA_GRAFO_BINARIO(V, P) \
+	template uint64_t tamanhoGrafoBinario<V, P>(const VisaoCSR<V, P>&); \
+	template uint64_t escreveGrafoBinario<V, P>(std::ostream&, const VisaoCSR<V, P>&); \
+	template VisaoCSR<V, P> interpretaGrafoBinario<V, P>(const char*, size_t, std::vector<size_t>&); \
+	template void salvaGrafoBinario<V, P>(const VisaoCSR<V, P>&, const std::string&);
+
+	CAMINHOMINIMO_TIPOS(INSTANCIA_GRAFO_BINARIO)
+}
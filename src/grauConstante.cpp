@@ -0,0 +1,94 @@
+#include "../headers/grauConstante.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace CaminhoMinimo {
+	template <typename Vertice, typename Peso>
+	GrafoGrauConstante<Vertice, Peso> transformaGrauConstante(const VisaoCSR<Vertice, Peso>& grafo, size_t grauMaximo)
+	{
+		if (grauMaximo == 0) grauMaximo = 1;
+
+		size_t tamanho = grafo.tamanho();
+		GrafoGrauConstante<Vertice, Peso> resultado;
+
+		// 1. Grau de entrada de cada vértice (o de saída vem direto do CSR)
+		std::vector<size_t> grauEntrada(tamanho, 0);
+		for (Vertice destino : grafo.destinos) grauEntrada[destino]++;
+
+		// 2. Quantas cópias cada vértice precisa e onde começam
+		auto numCopias = [&](size_t v) -> size_t {
+			size_t grauSaida = grafo.inicios[v + 1] - grafo.inicios[v];
+			if (grauSaida <= grauMaximo && grauEntrada[v] <= grauMaximo) return 1;
+			return std::max((grauSaida + grauMaximo - 1) / grauMaximo, (grauEntrada[v] + grauMaximo - 1) / grauMaximo);
+		};
+
+		resultado.representante.resize(tamanho);
+		size_t tamanhoNovo = 0;
+		for (size_t v = 0; v < tamanho; v++) {
+			resultado.representante[v] = static_cast<Vertice>(tamanhoNovo);
+			tamanhoNovo += numCopias(v);
+		}
+		if (tamanhoNovo >= static_cast<size_t>(std::numeric_limits<Vertice>::max()))
+			throw std::length_error("transformaGrauConstante: grafo transformado grande demais para o tipo de vertice escolhido");
+
+		resultado.original.resize(tamanhoNovo);
+		auto& novo = resultado.grafo;
+		novo.inicios.assign(tamanhoNovo + 1, 0);
+
+		// 3. Grau de saída de cada cópia: a fatia das arestas originais dela mais a aresta do ciclo
+		for (size_t v = 0; v < tamanho; v++) {
+			size_t base = resultado.representante[v];
+			size_t copias = numCopias(v);
+			size_t grauSaida = grafo.inicios[v + 1] - grafo.inicios[v];
+			for (size_t i = 0; i < copias; i++) {
+				resultado.original[base + i] = static_cast<Vertice>(v);
+				size_t fatia = (copias == 1) ? grauSaida : std::min(grauMaximo, grauSaida - std::min(grauSaida, i * grauMaximo));
+				novo.inicios[base + i + 1] = fatia + (copias > 1 ? 1 : 0);
+			}
+		}
+		for (size_t i = 0; i < tamanhoNovo; i++) novo.inicios[i + 1] += novo.inicios[i];
+
+		novo.destinos.resize(novo.inicios[tamanhoNovo]);
+		novo.pesos.resize(novo.inicios[tamanhoNovo]);
+		std::vector<size_t> cursor(novo.inicios.begin(), novo.inicios.end() - 1);
+
+		// 4. Arestas originais: a j-ésima saída de u sai da cópia j / grauMaximo de u e a r-ésima entrada
+		//    de v chega na cópia r / grauMaximo de v
+		std::vector<size_t> entradasVistas(tamanho, 0);
+		for (size_t u = 0; u < tamanho; u++) {
+			size_t copiasU = numCopias(u);
+			for (size_t aresta = grafo.inicios[u]; aresta < grafo.inicios[u + 1]; aresta++) {
+				size_t j = aresta - grafo.inicios[u];
+				size_t v = grafo.destinos[aresta];
+				size_t copiaOrigem = resultado.representante[u] + (copiasU == 1 ? 0 : j / grauMaximo);
+				size_t r = entradasVistas[v]++;
+				size_t copiaDestino = resultado.representante[v] + (numCopias(v) == 1 ? 0 : r / grauMaximo);
+
+				size_t posicao = cursor[copiaOrigem]++;
+				novo.destinos[posicao] = static_cast<Vertice>(copiaDestino);
+				novo.pesos[posicao] = grafo.pesos[aresta];
+			}
+		}
+
+		// 5. Ciclo de peso 0 entre as cópias de cada vértice dividido
+		for (size_t v = 0; v < tamanho; v++) {
+			size_t copias = numCopias(v);
+			if (copias == 1) continue;
+			size_t base = resultado.representante[v];
+			for (size_t i = 0; i < copias; i++) {
+				size_t posicao = cursor[base + i]++;
+				novo.destinos[posicao] = static_cast<Vertice>(base + (i + 1) % copias);
+				novo.pesos[posicao] = 0;
+			}
+		}
+
+		return resultado;
+	}
+
+#define INSTANCIA_GRAU_CONSTANTE(V, P) \
+	template GrafoGrauConstante<V, P> transformaGrauConstante<V, P>(const VisaoCSR<V, P>&, size_t);
+
+	CAMINHOMINIMO_TIPOS(INSTANCIA_GRAU_CONSTANTE)
+}
@@ -1,10 +1,12 @@
 #include "../headers/helpers.hpp"
 #include "../headers/algoritmo.hpp"
+#include "../headers/paralelo.hpp"
 
 #include "../lib/json.hpp"
 
 #include <vector>
 #include <random>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -58,44 +60,63 @@ std::pair<std::vector<double>, std::vector<size_t>> bellmanFord(const CaminhoMin
 }
 
 // Função que gera um grafo para teste usando lista de adjacencia.
-CaminhoMinimo::Grafo geraGrafo(size_t tamanho, double densidade) {
+// Equivale a sortear densidade * n * (n - 1) pares (origem, chegada) uniformes, descartando laços e
+// arestas repetidas. Em vez de sortear os pares em sequência, sorteamos quantos pares caem em cada
+// origem (multinomial, via binomiais encadeadas) e depois os destinos de cada origem. A distribuição
+// do grafo é a mesma, mas cada origem passa a ser independente: as repetidas são detectadas em O(1)
+// com um vetor de marcas por thread e as origens podem ser divididas entre threads.
+CaminhoMinimo::Grafo geraGrafo(size_t tamanho, double densidade, size_t numThreads) {
     // Criando um gerador de numeros aleatórios usando static para persistir durante várias calls a função
     static std::random_device semente;
     static std::mt19937 motor(semente());
-    std::uniform_int_distribution<size_t> escolheVertice(0, tamanho - 1);
-    std::uniform_real_distribution<double> escolhePeso(1.0, CaminhoMinimo::PESOMAX);
 
     CaminhoMinimo::Grafo grafo(tamanho);
+    if (tamanho < 2) return grafo; // só haveria laços
 
     // Calculando o número de arestas do grafo com base na densidade
     size_t maxArestas = static_cast<size_t>(densidade * tamanho * (tamanho - 1));
 
-    // Populando o grafo com pesos e direções aleatórias
-    for (size_t i = 0; i < maxArestas; i++){
-        size_t origem = escolheVertice(motor);
-        size_t chegada = escolheVertice(motor);
+    // 1. Quantos sorteios caem em cada origem
+    std::vector<size_t> sorteiosPorOrigem(tamanho);
+    size_t restantes = maxArestas;
+    for (size_t origem = 0; origem < tamanho && restantes > 0; origem++) {
+        std::binomial_distribution<size_t> escolheQuantidade(restantes, 1.0 / static_cast<double>(tamanho - origem));
+        sorteiosPorOrigem[origem] = escolheQuantidade(motor);
+        restantes -= sorteiosPorOrigem[origem];
+    }
+
+    // 2. Cada thread gera as origens de uma faixa com o seu próprio motor
+    numThreads = std::min(CaminhoMinimo::resolveThreads(numThreads), tamanho);
+    auto sementes = CaminhoMinimo::sorteiaSementes(motor, numThreads);
+    size_t tamFaixa = (tamanho + numThreads - 1) / numThreads;
+
+    CaminhoMinimo::paraCadaThread(numThreads, [&](size_t t) {
+        std::seed_seq sementeThread{ sementes[2 * t], sementes[2 * t + 1] };
+        std::mt19937 motorThread(sementeThread);
+        std::uniform_int_distribution<size_t> escolheVertice(0, tamanho - 1);
+        std::uniform_real_distribution<double> escolhePeso(1.0, CaminhoMinimo::PESOMAX);
+
+        // marca[chegada] == origem + 1 quando a aresta origem -> chegada já existe
+        std::vector<size_t> marca(tamanho, 0);
+
+        size_t primeira = std::min(t * tamFaixa, tamanho);
+        size_t ultima = std::min(primeira + tamFaixa, tamanho);
+        for (size_t origem = primeira; origem < ultima; origem++) {
+            grafo[origem].reserve(sorteiosPorOrigem[origem]);
+            for (size_t i = 0; i < sorteiosPorOrigem[origem]; i++) {
+                size_t chegada = escolheVertice(motorThread);
 #ifdef LIMPARUIDO
-        double peso = CaminhoMinimo::limpaRuido(escolhePeso(motor));
+                double peso = CaminhoMinimo::limpaRuido(escolhePeso(motorThread));
 #else
-        double peso = escolhePeso(motor);
+                double peso = escolhePeso(motorThread);
 #endif
-        if (origem == chegada) continue;
-
-        // --- A NOVA LÓGICA DE VERIFICAÇÃO ---
-        bool arestaJaExiste = false;
+                if (origem == chegada || marca[chegada] == origem + 1) continue;
 
-        // 1. Itere sobre os vizinhos que já estão na lista de 'origem'
-        for (const auto &parVizinho : grafo[origem]){
-            if (parVizinho.first == chegada){
-                // 2. Se o destino 'chegada' já está na lista, marque e pare
-                arestaJaExiste = true;
-                break;
+                marca[chegada] = origem + 1;
+                grafo[origem].emplace_back(chegada, peso);
             }
         }
-
-        // 3. Só adicione a aresta se ela NÃO foi encontrada
-        if (!arestaJaExiste) grafo[origem].emplace_back(chegada, peso);
-    }
+    });
     return grafo;
 }
 
@@ -139,104 +160,67 @@ void salvaGrafo(size_t tamanho, double densidade, const CaminhoMinimo::Grafo &gr
 }
 
 void imprimeArquivo(const std::string &caminhoArquivo){
-    // 1. Abre o arquivo para leitura
-    std::ifstream arquivoEntrada(caminhoArquivo);
-    if (!arquivoEntrada.is_open()){
-        std::cerr << "ERRO: Nao foi possivel abrir o arquivo: " << caminhoArquivo << std::endl;
-        return;
-    }
-
-    // 2. Analisa (Parse) o JSON
-    nlohmann::json listaDeTestes;
-    try {
-        listaDeTestes = nlohmann::json::parse(arquivoEntrada);
-        if (!listaDeTestes.is_array()){
-            std::cerr << "ERRO: O JSON nao e um array." << std::endl;
-            return;
-        }
-    }
-    catch (nlohmann::json::parse_error &e){
-        std::cerr << "ERRO: Falha ao analisar o JSON. " << e.what() << std::endl;
-        return;
-    }
-    arquivoEntrada.close();
-
-    // 3. Itera sobre cada "teste" no array JSON
-    for (const auto &teste : listaDeTestes){
+    // Lê um grafo por vez (SAX), então arquivos grandes não precisam caber inteiros na memória
+    percorreGrafosJSON(caminhoArquivo, [](const CaminhoMinimo::InstanciaCorpus &teste){
         // Imprime o cabeçalho de cada grafo
-        std::cout << "--- Grafo Gerado (Entrada) ID: " << teste["id"] << " ---" << std::endl;
+        std::cout << "--- Grafo Gerado (Entrada) ID: " << nlohmann::json(teste.id) << " ---" << std::endl;
 
-        const auto &grafoJSON = teste["grafo"];
+        const auto &grafo = teste.grafo;
 
-        // 4. Itera sobre cada VÉRTICE no grafoJSON (para imprimir o grafo)
-        for (size_t i = 0; i < grafoJSON.size(); ++i){
+        // Itera sobre cada VÉRTICE do grafo (para imprimir o grafo)
+        for (size_t i = 0; i < grafo.tamanho(); ++i){
             std::cout << "Vertice " << i << ": ";
-            const auto &listaVizinhos = grafoJSON[i];
 
-            if (listaVizinhos.empty()) std::cout << "(nenhuma aresta)";
+            if (grafo.inicios[i] == grafo.inicios[i + 1]) std::cout << "(nenhuma aresta)";
 
-            for (const auto &vizinhoPar : listaVizinhos){
-                // vizinhoPar[0] = destino, vizinhoPar[1] = peso
-                std::cout << "-> (" << vizinhoPar[0] << ", Peso: " << vizinhoPar[1] << ") ";
+            for (size_t aresta = grafo.inicios[i]; aresta < grafo.inicios[i + 1]; ++aresta){
+                std::cout << "-> (" << grafo.destinos[aresta] << ", Peso: " << nlohmann::json(grafo.pesos[aresta]) << ") ";
             }
             std::cout << std::endl;
         }
         std::cout << "--------------------------------------" << std::endl;
 
         // =======================================================
-        // == 5. IMPRIME A SOLUÇÃO (A NOVA SEÇÃO) ==
+        // == IMPRIME A SOLUÇÃO ==
         // =======================================================
-
-        // (Baseado no seu último código 'salvaGrafo',
-        // a chave é "solucao")
-        const auto &solucao = teste["solucao"];
         std::cout << "Solucao:" << std::endl;
 
         // Verifica se a solucao está vazia (placeholder)
-        if (solucao["distancias"].empty()) 
+        if (teste.distancias.empty()) 
             std::cout << "(Solucao pendente ou nao calculada)" << std::endl;
         else {
             // Imprime a tabela de resultados
             std::cout << "Vertice | Distancia | Predecessor" << std::endl;
             std::cout << "-------------------------------------" << std::endl;
 
-            const auto &distancias = solucao["distancias"];
-            const auto &predecessores = solucao["predecessores"];
-
             // Assumimos que o tamanho dos arrays de solucao é o mesmo
-            for (size_t i = 0; i < distancias.size(); ++i){
+            for (size_t i = 0; i < teste.distancias.size(); ++i){
                 std::cout << "   " << i << "    |     ";
-                
-                // CÓDIGO CORRIGIDO
-                if (distancias[i].is_null()) {
+
+                // o leitor converte o null do JSON de volta para infinito
+                if (teste.distancias[i] == std::numeric_limits<double>::infinity()) {
                     std::cout << "INF";
                 }
                 else {
-                    std::cout << distancias[i].get<double>(); // Use double, pois suas distâncias são double!
+                    std::cout << teste.distancias[i];
                 }
 
                 std::cout << "     |      ";
 
-                // Verifica se é nulo no JSON (caso não tenha sido salvo ou seja inválido)
-                if (predecessores[i].is_null()) {
+                if (i >= teste.predecessores.size()) {
                     std::cout << "-1";
                 }
-                else {
-                    // Usa size_t pois é o tipo que você definiu na classe/solver
-                    size_t pred = predecessores[i].get<size_t>();
-
+                else if (teste.predecessores[i] == std::numeric_limits<size_t>::max()) {
                     // Verifica se é o valor Sentinela (o maior size_t possível)
-                    if (pred == std::numeric_limits<size_t>::max()) {
-                        std::cout << "NULO";
-                    }
-                    else {
-                        std::cout << pred;
-                    }
+                    std::cout << "NULO";
+                }
+                else {
+                    std::cout << teste.predecessores[i];
                 }
                 std::cout << std::endl;
             }
         }
         std::cout << "======================================" << std::endl << std::endl;
-    }
+        return true;
+    });
 }
-
@@ -0,0 +1,211 @@
+#include "../headers/algoritmo.hpp"
+#include "../headers/grafoBinario.hpp"
+#include "../headers/paralelo.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace CaminhoMinimo {
+	static const char MAGICA_LANDMARKS[8] = "BMSSPLM";
+
+	// FNV-1a de 8 em 8 bytes, com um xor-shift depois de cada multiplicação para os bits altos chegarem nos baixos
+	static uint64_t misturaPalavra(uint64_t hash, uint64_t palavra)
+	{
+		hash = (hash ^ palavra) * 0x100000001b3ULL;
+		return hash ^ (hash >> 32);
+	}
+
+	static uint64_t misturaBytes(uint64_t hash, const void* dados, size_t tamanho)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(dados);
+		size_t i = 0;
+		for (; i + sizeof(uint64_t) <= tamanho; i += sizeof(uint64_t)) {
+			uint64_t palavra;
+			std::memcpy(&palavra, bytes + i, sizeof(palavra));
+			hash = misturaPalavra(hash, palavra);
+		}
+		for (; i < tamanho; i++) hash = misturaPalavra(hash, bytes[i]);
+		return hash;
+	}
+
+	// Impressão digital do grafo preparado. inicios entra como uint64 para não depender da largura de size_t
+	template <typename Vertice, typename Peso>
+	static uint64_t impressaoDigital(const VisaoCSR<Vertice, Peso>& grafo)
+	{
+		uint64_t hash = 0xcbf29ce484222325ULL;
+		for (size_t inicio : grafo.inicios) hash = misturaPalavra(hash, inicio);
+		hash = misturaBytes(hash, grafo.destinos.data(), grafo.destinos.size_bytes());
+		return misturaBytes(hash, grafo.pesos.data(), grafo.pesos.size_bytes());
+	}
+
+	// índice do maior valor (infinito conta como o mais longe); em empate fica o menor índice
+	template <typename Peso>
+	static size_t maisLonge(const std::vector<Peso>& dist)
+	{
+		size_t escolhido = 0;
+		for (size_t v = 1; v < dist.size(); v++)
+			if (dist[v] > dist[escolhido]) escolhido = v;
+		return escolhido;
+	}
+
+	template <typename Vertice, typename Peso>
+	long long Algoritmo<Vertice, Peso>::preprocessaLandmarks(size_t numLandmarks, size_t numThreads)
+	{
+		exigeGrafo("preprocessaLandmarks");
+		auto tempoInicial = std::chrono::high_resolution_clock::now();
+		exigeReverso(); // monta o transposto aqui, fora das threads, e o tempo dele entra no do pré-processamento
+
+		TabelaLandmarks<Vertice, Peso> tabela;
+		size_t k = std::min(numLandmarks, tamGrafo);
+		tabela.numVertices = tamGrafo;
+		tabela.numArestas = visaoGrafo.numArestas();
+		tabela.distDe.resize(tamGrafo * k);
+		tabela.distPara.resize(tamGrafo * k);
+
+		// Os Dijkstras rodam em Algoritmos que compartilham este grafo preparado, sem copiá-lo nem transpô-lo de novo, e
+		// recebem ids internos direto em dijkstra(). Os do grafo reverso só trocam a visão pela reversa, montada acima
+		auto dijkstraInterno = [](Algoritmo& trabalhador, Vertice origem) {
+			trabalhador.alvosConsulta.clear();
+			std::fill(trabalhador.distD.begin(), trabalhador.distD.end(), INFINITO);
+			trabalhador.distD[origem] = 0;
+			trabalhador.dijkstra({ origem });
+		};
+
+		// Farthest-first: cada landmark nova é o vértice mais longe das já escolhidas, medindo pela menor distância a
+		// partir delas. Quem nenhuma landmark alcança conta como infinitamente longe, então cada componente ganha a sua.
+		// Cada escolha depende da anterior, então esta parte é sequencial e já deixa pronta a tabela distDe
+		Algoritmo<Vertice, Peso> frente;
+		frente.compartilhaGrafo(*this);
+		if (k > 0) {
+			dijkstraInterno(frente, 0); // o vértice 0 só serve para achar a primeira landmark
+			Vertice proxima = static_cast<Vertice>(maisLonge(frente.distD));
+
+			std::vector<Peso> distMinima(tamGrafo, INFINITO);
+			for (size_t i = 0; i < k; i++) {
+				tabela.landmarks.push_back(proxima);
+				dijkstraInterno(frente, proxima);
+				for (size_t v = 0; v < tamGrafo; v++) {
+					Peso dist = frente.distD[v];
+					tabela.distDe[v * k + i] = dist;
+					distMinima[v] = std::min(distMinima[v], dist);
+				}
+				proxima = static_cast<Vertice>(maisLonge(distMinima));
+			}
+		}
+
+		// distPara sai de um Dijkstra por landmark no grafo reverso, independentes entre si. Cada thread escreve colunas
+		// inteiras em separado e a transposição para o layout por vértice fica para o fim, sem threads disputando linhas de cache
+		numThreads = std::min(resolveThreads(numThreads), std::max<size_t>(k, 1));
+		std::vector<std::vector<Peso>> colunas(k);
+		paraCadaThread(numThreads, [&](size_t t) {
+			Algoritmo<Vertice, Peso> tras;
+			tras.compartilhaGrafo(*this);
+			tras.exigeReverso();
+			std::swap(tras.visaoGrafo, tras.visaoReversa);
+			for (size_t i = t; i < k; i += numThreads) {
+				dijkstraInterno(tras, tabela.landmarks[i]);
+				colunas[i] = tras.distD;
+			}
+		});
+		for (size_t i = 0; i < k; i++)
+			for (size_t v = 0; v < tamGrafo; v++)
+				tabela.distPara[v * k + i] = colunas[i][v];
+
+		tabelaLandmarks = std::make_shared<const TabelaLandmarks<Vertice, Peso>>(std::move(tabela));
+		auto duracao = std::chrono::high_resolution_clock::now() - tempoInicial;
+		return std::chrono::duration_cast<std::chrono::microseconds>(duracao).count();
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::salvaLandmarks(const std::string& caminho) const
+	{
+		if (!tabelaLandmarks || tabelaLandmarks->vazia())
+			throw std::logic_error("salvaLandmarks: nenhuma tabela calculada ou carregada");
+
+		std::ofstream arquivo(caminho, std::ios::binary | std::ios::trunc);
+		if (!arquivo.is_open())
+			throw std::runtime_error("landmarks: nao foi possivel criar " + caminho);
+
+		CabecalhoLandmarks cabecalho{};
+		std::memcpy(cabecalho.magica, MAGICA_LANDMARKS, sizeof(cabecalho.magica));
+		cabecalho.versao = VERSAO_LANDMARKS;
+		cabecalho.marcaEndian = MARCA_ENDIAN;
+		cabecalho.bytesVertice = sizeof(Vertice);
+		cabecalho.bytesPeso = sizeof(Peso);
+		cabecalho.numVertices = tabelaLandmarks->numVertices;
+		cabecalho.numArestas = tabelaLandmarks->numArestas;
+		cabecalho.numLandmarks = tabelaLandmarks->numLandmarks();
+		const OpcoesPreprocessamento& opcoes = grafoCompartilhado->opcoes;
+		cabecalho.grauConstante = opcoes.grauConstante;
+		cabecalho.ordenacao = static_cast<uint32_t>(opcoes.ordenacao);
+		cabecalho.grauMaximo = opcoes.grauConstante ? opcoes.grauMaximo : 0;
+		cabecalho.impressaoGrafo = impressaoDigital(visaoGrafo);
+
+		arquivo.write(reinterpret_cast<const char*>(&cabecalho), sizeof(cabecalho));
+		arquivo.write(reinterpret_cast<const char*>(tabelaLandmarks->landmarks.data()), static_cast<std::streamsize>(tabelaLandmarks->landmarks.size() * sizeof(Vertice)));
+		arquivo.write(reinterpret_cast<const char*>(tabelaLandmarks->distDe.data()), static_cast<std::streamsize>(tabelaLandmarks->distDe.size() * sizeof(Peso)));
+		arquivo.write(reinterpret_cast<const char*>(tabelaLandmarks->distPara.data()), static_cast<std::streamsize>(tabelaLandmarks->distPara.size() * sizeof(Peso)));
+		if (!arquivo)
+			throw std::runtime_error("landmarks: falha ao escrever " + caminho);
+	}
+
+	template <typename Vertice, typename Peso>
+	void Algoritmo<Vertice, Peso>::carregaLandmarks(const std::string& caminho)
+	{
+		std::ifstream arquivo(caminho, std::ios::binary);
+		if (!arquivo.is_open())
+			throw std::runtime_error("landmarks: nao foi possivel abrir " + caminho);
+
+		CabecalhoLandmarks cabecalho{};
+		if (!arquivo.read(reinterpret_cast<char*>(&cabecalho), sizeof(cabecalho)))
+			throw std::runtime_error("landmarks: arquivo menor que o cabecalho");
+		if (std::memcmp(cabecalho.magica, MAGICA_LANDMARKS, sizeof(cabecalho.magica)) != 0)
+			throw std::runtime_error("landmarks: assinatura invalida");
+		if (cabecalho.marcaEndian != MARCA_ENDIAN)
+			throw std::runtime_error("landmarks: ordem de bytes diferente da maquina atual");
+		if (cabecalho.versao != VERSAO_LANDMARKS)
+			throw std::runtime_error("landmarks: versao " + std::to_string(cabecalho.versao) + " nao suportada");
+		if (cabecalho.bytesVertice != sizeof(Vertice) || cabecalho.bytesPeso != sizeof(Peso))
+			throw std::runtime_error("landmarks: larguras de vertice/peso diferentes das pedidas");
+		if (cabecalho.numVertices != tamGrafo || cabecalho.numArestas != visaoGrafo.numArestas())
+			throw std::runtime_error("landmarks: a tabela foi gerada para outro grafo");
+		const OpcoesPreprocessamento& opcoes = grafoCompartilhado->opcoes;
+		if (cabecalho.grauConstante != static_cast<uint32_t>(opcoes.grauConstante)
+			|| cabecalho.ordenacao != static_cast<uint32_t>(opcoes.ordenacao)
+			|| cabecalho.grauMaximo != (opcoes.grauConstante ? opcoes.grauMaximo : 0))
+			throw std::runtime_error("landmarks: a tabela foi gerada com outras opcoes de pre-processamento");
+		// o hash relê o grafo inteiro, mas a tabela que vem a seguir já é 2 * n * k pesos
+		if (cabecalho.impressaoGrafo != impressaoDigital(visaoGrafo))
+			throw std::runtime_error("landmarks: a tabela foi gerada para outro grafo do mesmo tamanho");
+		if (cabecalho.numLandmarks == 0 || cabecalho.numLandmarks > tamGrafo)
+			throw std::runtime_error("landmarks: numero de landmarks invalido");
+
+		TabelaLandmarks<Vertice, Peso> tabela;
+		size_t k = static_cast<size_t>(cabecalho.numLandmarks);
+		tabela.numVertices = tamGrafo;
+		tabela.numArestas = visaoGrafo.numArestas();
+		tabela.landmarks.resize(k);
+		tabela.distDe.resize(tamGrafo * k);
+		tabela.distPara.resize(tamGrafo * k);
+
+		arquivo.read(reinterpret_cast<char*>(tabela.landmarks.data()), static_cast<std::streamsize>(k * sizeof(Vertice)));
+		arquivo.read(reinterpret_cast<char*>(tabela.distDe.data()), static_cast<std::streamsize>(tabela.distDe.size() * sizeof(Peso)));
+		arquivo.read(reinterpret_cast<char*>(tabela.distPara.data()), static_cast<std::streamsize>(tabela.distPara.size() * sizeof(Peso)));
+		if (!arquivo)
+			throw std::runtime_error("landmarks: arquivo truncado");
+		for (Vertice landmark : tabela.landmarks)
+			if (landmark >= tamGrafo) throw std::runtime_error("landmarks: landmark fora do grafo");
+
+		tabelaLandmarks = std::make_shared<const TabelaLandmarks<Vertice, Peso>>(std::move(tabela));
+	}
+
+#define INSTANCIA_LANDMARKS(V, P) \
+	template long long Algoritmo<V, P>::preprocessaLandmarks(size_t, size_t); \
+	template void Algoritmo<V, P>::salvaLandmarks(const std::string&) const; \
+	template void Algoritmo<V, P>::carregaLandmarks(const std::string&);
+
+	CAMINHOMINIMO_TIPOS(INSTANCIA_LANDMARKS)
+}
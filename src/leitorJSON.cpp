@@ -0,0 +1,131 @@
+#include "../headers/helpers.hpp"
+
+#include "../lib/json.hpp"
+
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+
+// Leitor SAX para os arquivos gerados por salvaGrafo. Em vez de montar o DOM do arquivo inteiro,
+// só o grafo sendo lido fica em memória e ele já é montado direto em CSR.
+// Formato esperado: [ { "id": ..., "parametros": {...}, "grafo": [[[destino, peso], ...], ...], "solucao": {...} }, ... ]
+// Profundidades: 1 = lista de testes, 2 = teste, 3 = valor de uma chave do teste, 4 = lista de vizinhos / vetor da solução, 5 = par (destino, peso).
+class LeitorSaxGrafos : public nlohmann::json_sax<nlohmann::json> {
+public:
+    explicit LeitorSaxGrafos(const std::function<bool(const CaminhoMinimo::InstanciaCorpus&)>& aoLerGrafo) : aoLerGrafo(aoLerGrafo) {}
+
+    bool null() override { return numero(0.0, true); }
+    bool boolean(bool) override { return true; }
+    bool number_integer(number_integer_t valor) override { return numero(static_cast<double>(valor), false, static_cast<size_t>(valor)); }
+    bool number_unsigned(number_unsigned_t valor) override { return numero(static_cast<double>(valor), false, static_cast<size_t>(valor)); }
+    bool number_float(number_float_t valor, const string_t&) override { return numero(valor, false, static_cast<size_t>(valor)); }
+    bool binary(binary_t&) override { return true; }
+
+    bool string(string_t& valor) override {
+        if (profundidade == 2 && chaveTeste == "id") atual.id = valor;
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        if (profundidade == 0) {
+            erro = "O JSON nao e um array.";
+            return false;
+        }
+        profundidade++;
+        if (profundidade == 2) {
+            atual = CaminhoMinimo::InstanciaCorpus();
+            chaveTeste.clear();
+        }
+        return true;
+    }
+
+    bool key(string_t& valor) override {
+        if (profundidade == 2) chaveTeste = valor;
+        else if (profundidade == 3) chaveInterna = valor;
+        return true;
+    }
+
+    bool end_object() override {
+        if (profundidade == 2) {
+            // o gabarito pode não ter sido salvo; nesse caso deixamos os vetores vazios
+            if (atual.grafo.inicios.empty()) atual.grafo.inicios.push_back(0);
+            if (atual.tamanho == 0) atual.tamanho = atual.grafo.tamanho();
+            if (!aoLerGrafo(atual)) {
+                interrompido = true;
+                return false;
+            }
+        }
+        profundidade--;
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        profundidade++;
+        if (profundidade == 3 && chaveTeste == "grafo") atual.grafo.inicios.assign(1, 0);
+        if (profundidade == 5) posicaoPar = 0;
+        return true;
+    }
+
+    bool end_array() override {
+        // fim da lista de vizinhos de um vértice
+        if (profundidade == 4 && chaveTeste == "grafo") atual.grafo.inicios.push_back(atual.grafo.destinos.size());
+        profundidade--;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& excecao) override {
+        erro = std::string("Falha ao analisar o JSON. ") + excecao.what();
+        return false;
+    }
+
+    bool interrompido = false;
+    std::string erro;
+
+private:
+    bool numero(double valor, bool nulo, size_t inteiro = 0) {
+        if (profundidade == 5 && chaveTeste == "grafo") {
+            if (posicaoPar == 0) destino = inteiro;
+            else if (posicaoPar == 1) {
+                atual.grafo.destinos.push_back(destino);
+                atual.grafo.pesos.push_back(valor);
+            }
+            posicaoPar++;
+        }
+        else if (profundidade == 4 && chaveTeste == "solucao") {
+            // o json grava infinito como null
+            if (chaveInterna == "distancias") atual.distancias.push_back(nulo ? std::numeric_limits<double>::infinity() : valor);
+            else if (chaveInterna == "predecessores") atual.predecessores.push_back(nulo ? std::numeric_limits<size_t>::max() : inteiro);
+        }
+        else if (profundidade == 3 && chaveTeste == "parametros") {
+            if (chaveInterna == "tamanho") atual.tamanho = inteiro;
+            else if (chaveInterna == "densidade") atual.densidade = valor;
+        }
+        return true;
+    }
+
+private:
+    const std::function<bool(const CaminhoMinimo::InstanciaCorpus&)>& aoLerGrafo;
+    CaminhoMinimo::InstanciaCorpus atual;
+    int profundidade = 0;
+    std::string chaveTeste;   // chave atual dentro do teste (id, parametros, grafo, solucao)
+    std::string chaveInterna; // chave atual dentro de parametros/solucao
+    size_t posicaoPar = 0;
+    size_t destino = 0;
+};
+
+bool percorreGrafosJSON(const std::string& caminhoArquivo, const std::function<bool(const CaminhoMinimo::InstanciaCorpus&)>& aoLerGrafo) {
+    std::ifstream arquivoEntrada(caminhoArquivo);
+    if (!arquivoEntrada.is_open()) {
+        std::cerr << "ERRO: Nao foi possivel abrir o arquivo: " << caminhoArquivo << std::endl;
+        return false;
+    }
+
+    LeitorSaxGrafos leitor(aoLerGrafo);
+    bool completo = nlohmann::json::sax_parse(arquivoEntrada, &leitor);
+    if (!completo && !leitor.interrompido) {
+        std::cerr << "ERRO: " << leitor.erro << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,36 @@
+#include "../headers/algoritmo.hpp"
+#include "../headers/paralelo.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace CaminhoMinimo {
+    // Cada thread monta um único Algoritmo que compartilha o grafo e o reaproveita em todas as origens que pegar, então
+    // distD e os heaps são alocados uma vez por thread e não por busca. O grafo só é lido, por isso as threads não
+    // precisam se coordenar fora da distribuição dos índices
+    template <typename Vertice, typename Peso>
+    long long Algoritmo<Vertice, Peso>::execLote(const std::vector<Vertice>& origens, MetodoLote metodo, const ConsumidorLote& consome, size_t numThreads) const
+    {
+        exigeGrafo("execLote"); // antes das threads: sem grafo, compartilhaGrafo dentro delas leria um ponteiro nulo
+        auto tempoInicial = std::chrono::high_resolution_clock::now();
+
+        numThreads = std::min(resolveThreads(numThreads), std::max<size_t>(origens.size(), 1));
+        std::vector<Algoritmo> trabalhadores(numThreads);
+        paraCadaIndice(origens.size(), numThreads, [&](size_t t, size_t i) {
+            Algoritmo& trabalhador = trabalhadores[t];
+            if (trabalhador.grafoCompartilhado != grafoCompartilhado) trabalhador.compartilhaGrafo(*this);
+
+            if (metodo == MetodoLote::BMSSP) trabalhador.execBmssp(origens[i]);
+            else trabalhador.execDijkstra(origens[i]);
+            consome(i, trabalhador);
+        });
+
+        auto duracao = std::chrono::high_resolution_clock::now() - tempoInicial;
+        return std::chrono::duration_cast<std::chrono::microseconds>(duracao).count();
+    }
+
+#define INSTANCIA_LOTE(V, P) \
+    template long long Algoritmo<V, P>::execLote(const std::vector<V>&, MetodoLote, const ConsumidorLote&, size_t) const;
+
+    CAMINHOMINIMO_TIPOS(INSTANCIA_LOTE)
+}
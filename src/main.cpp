@@ -1,11 +1,19 @@
 #include "../headers/algoritmo.hpp"
 #include "../headers/helpers.hpp"
+#include "../headers/carregaGrafo.hpp"
+#include "../headers/geradores.hpp"
+#include "../headers/paralelo.hpp"
 #include "../lib/json.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <string>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <stdexcept>
 #include <iomanip> // Necessário para formatar a densidade no nome do arquivo se desejar precisão
 
 // Estrutura para guardar informações sobre os erros encontrados (mantida para verificação)
@@ -14,10 +22,401 @@ struct InfoErro {
     int tamanhoGrafo;
     size_t verticeDivergente;
     double valorDijkstra;
-    double valorBMSSP;
+    double valorDivergente; // do primeiro algoritmo que discordou do Dijkstra
 };
 
-int main() {
+// Landmarks do ALT usadas nas consultas de comparaGrafo. 16 corta o tempo da consulta pela metade na grade; nos grafos
+// aleatórios o ALT ganha pouco com qualquer número razoável delas (ver preprocessaLandmarks)
+constexpr size_t NUMLANDMARKS = 16;
+
+// Orçamento de cada fatia do BMSSP em fatias, em micros, e quantas vezes esse orçamento uma fatia pode levar antes de contar como
+// falha. A fatia dura o orçamento mais um passo (ver continuaBmssp); a folga cobre o maior passo e o ruído do relógio
+constexpr long long ORCAMENTOFATIA = 1000;
+constexpr long long FOLGAFATIA = 8;
+
+// Delta do delta-stepping: peso máximo dividido pelo grau médio (heurística de Meyer e Sanders)
+double escolheDelta(double pesoMax, size_t numVertices, size_t numArestas) {
+    double grauMedio = numVertices > 0 ? static_cast<double>(numArestas) / static_cast<double>(numVertices) : 1.0;
+    return pesoMax / std::max(grauMedio, 1.0);
+}
+
+// Primeiro vértice em que a última busca de algoritmo difere de referencia (ids originais), ou referencia.size().
+// Lê as distâncias direto de getResultado: só a referência precisa ser copiada
+size_t primeiraDivergencia(const CaminhoMinimo::Algoritmo<>& algoritmo, const std::vector<double>& referencia) {
+    auto resultado = algoritmo.getResultado();
+    for (size_t v = 0; v < referencia.size(); v++)
+        if (resultado.distancia(v) != referencia[v]) return v;
+    return referencia.size();
+}
+
+bool mesmasDistancias(const CaminhoMinimo::Algoritmo<>& algoritmo, const std::vector<double>& referencia) {
+    return primeiraDivergencia(algoritmo, referencia) == referencia.size();
+}
+
+// Roda BMSSP e Dijkstra uma vez sobre um grafo grande (lido de arquivo ou gerado) e confere os resultados
+int comparaGrafo(const CaminhoMinimo::GrafoCSR<>& grafo, const std::string& descricao) {
+    std::cout << "Grafo " << descricao << ": " << grafo.tamanho() << " vertices, " << grafo.numArestas() << " arestas" << std::endl;
+
+    CaminhoMinimo::Algoritmo<> algos;
+    algos.setGrafo(grafo);
+
+    // o Dijkstra é a referência e a única cópia; cada outro algoritmo é conferido logo depois de rodar
+    long long tempoDijkstra = algos.execDijkstra(0);
+    const std::vector<double> resultadoDijkstra = algos.getDist();
+    std::string divergente;
+    auto confere = [&](const CaminhoMinimo::Algoritmo<>& algoritmo, const char* nome) {
+        if (divergente.empty() && !mesmasDistancias(algoritmo, resultadoDijkstra)) divergente = nome;
+    };
+
+    long long tempoBMSSP = algos.execBmssp(0);
+    confere(algos, "BMSSP");
+
+    algos.setFilaDijkstra(CaminhoMinimo::FilaDijkstra::Binaria);
+    long long tempoDijkstraBinaria = algos.execDijkstra(0);
+    confere(algos, "Dijkstra binaria");
+
+    algos.setFilaDijkstra(CaminhoMinimo::FilaDijkstra::Radix);
+    long long tempoDijkstraRadix = algos.execDijkstra(0);
+    confere(algos, "Dijkstra radix");
+
+    // grafos lidos de arquivo podem ter qualquer faixa de pesos: o Dial mede a dele em setGrafo e o delta vem do maior peso
+    double pesoMaximo = CaminhoMinimo::PESOMAX;
+    if (grafo.numArestas() > 0)
+        pesoMaximo = *std::max_element(grafo.pesos.begin(), grafo.pesos.end());
+    algos.setFilaDijkstra(CaminhoMinimo::FilaDijkstra::Dial);
+    long long tempoDijkstraDial = algos.execDijkstra(0);
+    confere(algos, "Dijkstra Dial");
+
+    long long tempoDeltaStepping = algos.execDeltaStepping(0, escolheDelta(pesoMaximo, grafo.tamanho(), grafo.numArestas()));
+    confere(algos, "Delta-stepping");
+
+    std::cout << "Tempo_Dijkstra_micros: " << tempoDijkstra << std::endl;
+    std::cout << "Tempo_Dijkstra_Binaria_micros: " << tempoDijkstraBinaria << std::endl;
+    std::cout << "Tempo_Dijkstra_Radix_micros: " << tempoDijkstraRadix << std::endl;
+    std::cout << "Tempo_Dijkstra_Dial_micros: " << tempoDijkstraDial << std::endl;
+    std::cout << "Tempo_DeltaStepping_micros: " << tempoDeltaStepping << std::endl;
+    std::cout << "Tempo_BMSSP_micros: " << tempoBMSSP << std::endl;
+
+    // BMSSP de novo, agora sobre o grafo com grau constante
+    CaminhoMinimo::Algoritmo<> algosGrauConstante;
+    CaminhoMinimo::OpcoesPreprocessamento opcoes;
+    opcoes.grauConstante = true;
+    algosGrauConstante.setGrafo(grafo.visao(), opcoes);
+
+    long long tempoBMSSPGrauConstante = algosGrauConstante.execBmssp(0);
+    confere(algosGrauConstante, "BMSSP grau constante");
+
+    std::cout << "Tempo_GrauConstante_micros: " << algosGrauConstante.getTempoPreprocessamento() << std::endl;
+    std::cout << "Tempo_BMSSP_GrauConstante_micros: " << tempoBMSSPGrauConstante << std::endl;
+
+    if (!divergente.empty()) {
+        std::cerr << "[DIVERGENCIA] " << divergente << std::endl;
+        return 1;
+    }
+    // BMSSP em fatias de até 1 ms, como um serviço que intercala a busca longa com outras: tem que dar a mesma árvore e
+    // nenhuma fatia pode passar muito do orçamento
+    size_t numFatias = 0;
+    long long maiorFatia = 0;
+    algos.iniciaBmssp(0);
+    for (bool terminou = false; !terminou; numFatias++) {
+        auto inicioFatia = std::chrono::high_resolution_clock::now();
+        terminou = algos.continuaBmssp(std::chrono::microseconds(ORCAMENTOFATIA));
+        auto duracaoFatia = std::chrono::high_resolution_clock::now() - inicioFatia;
+        maiorFatia = std::max<long long>(maiorFatia, std::chrono::duration_cast<std::chrono::microseconds>(duracaoFatia).count());
+    }
+    if (!mesmasDistancias(algos, resultadoDijkstra)) {
+        std::cerr << "[DIVERGENCIA] BMSSP em fatias" << std::endl;
+        return 1;
+    }
+    std::cout << "BMSSP_Fatias (ate " << ORCAMENTOFATIA << " micros cada): " << numFatias << " fatias, maior " << maiorFatia << " micros" << std::endl;
+    if (maiorFatia > FOLGAFATIA * ORCAMENTOFATIA) {
+        std::cerr << "[DIVERGENCIA] BMSSP em fatias: uma fatia levou " << maiorFatia << " micros, mais de " << FOLGAFATIA
+                  << " vezes o orcamento de " << ORCAMENTOFATIA << std::endl;
+        return 1;
+    }
+
+    // Busca pausada e largada: a execBmssp seguinte descarta a que estava em andamento e não pode herdar nada dela, com a
+    // pausa em vários pontos da recursão
+    for (size_t passos : { 20, 200, 2000 }) {
+        algos.iniciaBmssp(0);
+        algos.continuaBmssp(std::chrono::microseconds::max(), passos);
+        algos.execBmssp(0);
+        if (!mesmasDistancias(algos, resultadoDijkstra)) {
+            std::cerr << "[DIVERGENCIA] BMSSP depois de abandonar uma busca pausada em " << passos << " passos" << std::endl;
+            return 1;
+        }
+    }
+
+    // Consultas ponto a ponto: alvos espalhados pelo grafo, cada um conferido com a árvore completa
+    long long tempoConsultaDijkstra = 0, tempoConsultaBMSSP = 0, tempoConsultaBidirecional = 0, tempoConsultaAEstrela = 0;
+    long long tempoLandmarks = algos.preprocessaLandmarks(NUMLANDMARKS);
+    size_t numConsultas = std::min<size_t>(grafo.tamanho(), 10);
+    for (size_t i = 1; i <= numConsultas; i++) {
+        size_t alvo = (grafo.tamanho() - 1) * i / numConsultas;
+        tempoConsultaDijkstra += algos.execDijkstra(0, { alvo });
+        double distDijkstra = algos.getDist(alvo);
+        tempoConsultaBMSSP += algos.execBmssp(0, { alvo });
+        double distBMSSP = algos.getDist(alvo);
+        tempoConsultaBidirecional += algos.execDijkstraBidirecional(0, alvo);
+        double distBidirecional = algos.getDist(alvo);
+        tempoConsultaAEstrela += algos.execAEstrela(0, alvo);
+        if (distDijkstra != resultadoDijkstra[alvo] || distBMSSP != resultadoDijkstra[alvo]
+            || distBidirecional != resultadoDijkstra[alvo] || algos.getDist(alvo) != resultadoDijkstra[alvo]) {
+            std::cerr << "[DIVERGENCIA] Consulta ate o vertice " << alvo << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "Tempo_Consulta_Dijkstra_micros (media de " << numConsultas << "): " << tempoConsultaDijkstra / std::max<size_t>(numConsultas, 1) << std::endl;
+    std::cout << "Tempo_Consulta_BMSSP_micros (media de " << numConsultas << "): " << tempoConsultaBMSSP / std::max<size_t>(numConsultas, 1) << std::endl;
+    std::cout << "Tempo_Consulta_Bidirecional_micros (media de " << numConsultas << "): " << tempoConsultaBidirecional / std::max<size_t>(numConsultas, 1) << std::endl;
+    std::cout << "Tempo_Landmarks_micros (" << NUMLANDMARKS << " landmarks): " << tempoLandmarks << std::endl;
+    std::cout << "Tempo_Consulta_AEstrela_micros (media de " << numConsultas << "): " << tempoConsultaAEstrela / std::max<size_t>(numConsultas, 1) << std::endl;
+
+    // Bidirecional contra a árvore completa do execDijkstra em pares origem/alvo sorteados: mesma distância e um caminho
+    // que sai da origem e usa arestas do grafo. Além do grafo original e do de grau constante, roda com grau constante numa
+    // cópia com pesos inteiros (empates) e peso 0 em toda aresta que chega num múltiplo de 8. Aí um caminho mínimo pode
+    // sair das cópias de um vértice e voltar a elas, o caso em que ajustaRepresentantes já fechou um ciclo e travou
+    CaminhoMinimo::GrafoCSR<> grafoPesoZero = grafo;
+    for (size_t aresta = 0; aresta < grafo.numArestas(); aresta++)
+        grafoPesoZero.pesos[aresta] = grafo.destinos[aresta] % 8 == 0 ? 0.0 : std::floor(grafo.pesos[aresta]);
+    CaminhoMinimo::Algoritmo<> algosPesoZero;
+    algosPesoZero.setGrafo(grafoPesoZero.visao(), opcoes);
+
+    std::mt19937 sorteiaPar(42);
+    std::uniform_int_distribution<size_t> escolheVertice(0, grafo.tamanho() - 1);
+    size_t numParesBidirecional = 0;
+    for (CaminhoMinimo::Algoritmo<>* algoritmo : { &algos, &algosGrauConstante, &algosPesoZero }) {
+        for (size_t i = 0; i < 8; i++) {
+            size_t origem = escolheVertice(sorteiaPar);
+            algoritmo->execDijkstra(origem);
+            std::vector<double> distOrigem = algoritmo->getDist();
+            for (size_t j = 0; j < 32; j++, numParesBidirecional++) {
+                size_t alvo = escolheVertice(sorteiaPar);
+                algoritmo->execDijkstraBidirecional(origem, alvo);
+                auto resultado = algoritmo->getResultado();
+                std::vector<size_t> caminho = resultado.caminho(alvo);
+                bool valido = resultado.distancia(alvo) == distOrigem[alvo]
+                    && (caminho.empty() ? !(distOrigem[alvo] < CaminhoMinimo::Algoritmo<>::INFINITO) : caminho.front() == origem && caminho.back() == alvo);
+                for (size_t k = 0; valido && k + 1 < caminho.size(); k++)
+                    valido = std::find(grafo.destinos.begin() + grafo.inicios[caminho[k]], grafo.destinos.begin() + grafo.inicios[caminho[k] + 1], caminho[k + 1])
+                        != grafo.destinos.begin() + grafo.inicios[caminho[k] + 1];
+                if (!valido) {
+                    std::cerr << "[DIVERGENCIA] Bidirecional de " << origem << " ate " << alvo << std::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+    std::cout << "Bidirecional igual ao Dijkstra em " << numParesBidirecional << " pares" << std::endl;
+
+    // Várias origens (ex: instalação mais próxima), cada uma com um deslocamento inicial diferente
+    std::vector<size_t> origens;
+    std::vector<double> deslocamentos;
+    for (size_t v = 0; v < grafo.tamanho(); v += std::max<size_t>(grafo.tamanho() / 16, 1)) {
+        origens.push_back(v);
+        deslocamentos.push_back(static_cast<double>(origens.size() % 4));
+    }
+    long long tempoMultiDijkstra = algos.execDijkstra(origens, deslocamentos);
+    std::vector<double> resultadoMultiDijkstra = algos.getDist();
+    long long tempoMultiBMSSP = algos.execBmssp(origens, deslocamentos);
+    if (!mesmasDistancias(algos, resultadoMultiDijkstra)) {
+        std::cerr << "[DIVERGENCIA] Varias origens" << std::endl;
+        return 1;
+    }
+    std::cout << "Tempo_MultiOrigem_Dijkstra_micros (" << origens.size() << " origens): " << tempoMultiDijkstra << std::endl;
+    std::cout << "Tempo_MultiOrigem_BMSSP_micros (" << origens.size() << " origens): " << tempoMultiBMSSP << std::endl;
+
+    // BMSSP com empates: na cópia de pesos inteiros e peso 0 (acima), com e sem grau constante, a partir do vértice 0 e das
+    // mesmas origens todas com deslocamento 0. Pega o findPivots contando como completa uma árvore com vértice empatado de
+    // outra camada e o Pull que parava com U cheio deixando em D chave menor que B
+    CaminhoMinimo::Algoritmo<> algosEmpates;
+    algosEmpates.setGrafo(grafoPesoZero.visao());
+    const std::vector<double> deslocamentosZero(origens.size(), 0.0);
+    for (CaminhoMinimo::Algoritmo<>* algoritmo : { &algosEmpates, &algosPesoZero }) {
+        for (bool variasOrigens : { false, true }) {
+            if (variasOrigens) algoritmo->execDijkstra(origens, deslocamentosZero);
+            else algoritmo->execDijkstra(0);
+            std::vector<double> esperado = algoritmo->getDist();
+            if (variasOrigens) algoritmo->execBmssp(origens, deslocamentosZero);
+            else algoritmo->execBmssp(0);
+            if (!mesmasDistancias(*algoritmo, esperado)) {
+                std::cerr << "[DIVERGENCIA] BMSSP com empates" << (variasOrigens ? " (varias origens)" : "") << std::endl;
+                return 1;
+            }
+        }
+    }
+    std::cout << "BMSSP igual ao Dijkstra com empates e peso 0" << std::endl;
+
+    // Lote: as mesmas origens, agora uma busca completa para cada, em sequência e repartidas entre todos os núcleos
+    auto somaFinitas = [](std::span<const double> dist) {
+        double soma = 0;
+        for (double d : dist) if (d < CaminhoMinimo::Algoritmo<>::INFINITO) soma += d;
+        return soma;
+    };
+    std::vector<double> somaSequencial(origens.size()), somaLote(origens.size());
+    long long tempoSequencial = 0;
+    for (size_t i = 0; i < origens.size(); i++) {
+        tempoSequencial += algos.execDijkstra(origens[i]);
+        somaSequencial[i] = somaFinitas(algos.getResultado().dist);
+    }
+    std::cout << "Tempo_Sequencial_Dijkstra_micros (" << origens.size() << " origens): " << tempoSequencial << std::endl;
+    // 1, 2, 4... threads até o número de núcleos (e ao menos 2, para a divisão do trabalho rodar mesmo em 1 núcleo)
+    size_t numNucleos = CaminhoMinimo::resolveThreads(0);
+    long long tempoUmaThread = 0;
+    for (size_t numThreads = 1; numThreads <= std::max<size_t>(numNucleos, 2); numThreads *= 2) {
+        std::fill(somaLote.begin(), somaLote.end(), -1.0);
+        long long tempoLote = algos.execLote(origens, CaminhoMinimo::MetodoLote::Dijkstra,
+            [&](size_t i, const CaminhoMinimo::Algoritmo<>& trabalhador) { somaLote[i] = somaFinitas(trabalhador.getResultado().dist); }, numThreads);
+        if (somaLote != somaSequencial) {
+            std::cerr << "[DIVERGENCIA] Lote com " << numThreads << " threads" << std::endl;
+            return 1;
+        }
+        if (numThreads == 1) tempoUmaThread = tempoLote;
+        std::cout << "Tempo_Lote_Dijkstra_micros (" << origens.size() << " origens, " << numThreads << " threads): " << tempoLote
+            << ", ganho " << std::fixed << std::setprecision(2) << static_cast<double>(tempoUmaThread) / std::max(tempoLote, 1LL) << std::defaultfloat << std::endl;
+    }
+
+    // sem setGrafo, execLote tem que recusar antes de abrir as threads
+    try {
+        CaminhoMinimo::Algoritmo<>().execLote(origens, CaminhoMinimo::MetodoLote::Dijkstra, [](size_t, const CaminhoMinimo::Algoritmo<>&) {});
+        std::cerr << "[DIVERGENCIA] execLote sem grafo nao lancou" << std::endl;
+        return 1;
+    }
+    catch (const std::logic_error&) {}
+
+    std::cout << "Sucesso! Nenhuma divergencia encontrada entre os algoritmos." << std::endl;
+    return 0;
+}
+
+// Mede Dijkstra e BMSSP com cada renumeração de vértices e mostra o ganho sobre os ids originais
+int comparaOrdenacoes(const CaminhoMinimo::GrafoCSR<>& grafo, const std::string& descricao) {
+    using CaminhoMinimo::Ordenacao;
+    std::cout << "Grafo " << descricao << ": " << grafo.tamanho() << " vertices, " << grafo.numArestas() << " arestas" << std::endl;
+    std::cout << "Ordenacao,Tempo_Preprocessamento_micros,Tempo_Dijkstra_micros,Tempo_BMSSP_micros,Ganho_Dijkstra,Ganho_BMSSP" << std::endl;
+
+    const std::pair<Ordenacao, const char*> ordenacoes[] = {
+        { Ordenacao::Nenhuma, "nenhuma" }, { Ordenacao::BFS, "bfs" }, { Ordenacao::RCM, "rcm" }, { Ordenacao::Grau, "grau" }
+    };
+
+    std::vector<double> referencia;
+    double tempoDijkstraBase = 0, tempoBMSSPBase = 0;
+    int erros = 0;
+
+    for (const auto& [ordenacao, nome] : ordenacoes) {
+        CaminhoMinimo::Algoritmo<> algos;
+        CaminhoMinimo::OpcoesPreprocessamento opcoes;
+        opcoes.ordenacao = ordenacao;
+        algos.setGrafo(grafo.visao(), opcoes);
+
+        long long tempoDijkstra = algos.execDijkstra(0);
+        if (ordenacao == Ordenacao::Nenhuma) referencia = algos.getDist();
+        bool iguais = mesmasDistancias(algos, referencia);
+        long long tempoBMSSP = algos.execBmssp(0);
+        iguais = iguais && mesmasDistancias(algos, referencia);
+
+        if (ordenacao == Ordenacao::Nenhuma) {
+            tempoDijkstraBase = static_cast<double>(tempoDijkstra);
+            tempoBMSSPBase = static_cast<double>(tempoBMSSP);
+        }
+        if (!iguais) {
+            std::cerr << "[DIVERGENCIA] Ordenacao " << nome << std::endl;
+            erros++;
+        }
+
+        std::cout << nome << "," << algos.getTempoPreprocessamento() << "," << tempoDijkstra << "," << tempoBMSSP << ","
+            << std::fixed << std::setprecision(2) << tempoDijkstraBase / std::max(tempoDijkstra, 1LL) << ","
+            << tempoBMSSPBase / std::max(tempoBMSSP, 1LL) << std::defaultfloat << std::endl;
+    }
+    return erros;
+}
+
+// BMSSP completo com as duas marcações de camada do findPivots: zerando as n marcas a cada camada (como era antes) e
+// trocando só a geração. Mesmas origens nas duas, e as distâncias têm que bater com as do Dijkstra
+int comparaMarcacaoCamadas(const CaminhoMinimo::GrafoCSR<>& grafo, const std::string& descricao) {
+    using CaminhoMinimo::MarcacaoCamadas;
+    std::cout << "Grafo " << descricao << ": " << grafo.tamanho() << " vertices, " << grafo.numArestas() << " arestas" << std::endl;
+    if (grafo.tamanho() == 0) return 0;
+
+    CaminhoMinimo::Algoritmo<> algos;
+    algos.setGrafo(grafo);
+    std::vector<size_t> origens;
+    for (size_t v = 0; v < grafo.tamanho() && origens.size() < 8; v += std::max<size_t>(grafo.tamanho() / 8, 1)) origens.push_back(v);
+
+    std::vector<std::vector<double>> referencias;
+    for (size_t origem : origens) {
+        algos.execDijkstra(origem);
+        referencias.push_back(algos.getDist());
+    }
+
+    long long tempos[2] = { 0, 0 };
+    const MarcacaoCamadas marcacoes[2] = { MarcacaoCamadas::Limpeza, MarcacaoCamadas::Geracao };
+    algos.execBmssp(origens[0]); // aloca a área do BMSSP fora da medição
+    for (int m = 0; m < 2; m++) {
+        algos.setMarcacaoCamadas(marcacoes[m]);
+        for (size_t i = 0; i < origens.size(); i++) {
+            tempos[m] += algos.execBmssp(origens[i]);
+            if (!mesmasDistancias(algos, referencias[i])) {
+                std::cerr << "[DIVERGENCIA] Marcacao de camadas, origem " << origens[i] << std::endl;
+                return 1;
+            }
+        }
+    }
+    std::cout << "Origens: " << origens.size() << std::endl;
+    std::cout << "Tempo_BMSSP_Marcacao_Limpeza_micros: " << tempos[0] << std::endl;
+    std::cout << "Tempo_BMSSP_Marcacao_Geracao_micros: " << tempos[1] << std::endl;
+    std::cout << "Ganho: " << std::fixed << std::setprecision(2) << static_cast<double>(tempos[0]) / std::max(tempos[1], 1LL) << std::defaultfloat << std::endl;
+    return 0;
+}
+
+// Lê ou gera o grafo descrito por argv[1..]
+CaminhoMinimo::GrafoCSR<> montaGrafo(int argc, char* argv[]) {
+    std::string modo = argv[1];
+    CaminhoMinimo::GrafoCSR<> grafo;
+
+    if (modo == "esparso" && argc > 3)
+        grafo = CaminhoMinimo::geraGrafoEsparso(std::stoull(argv[2]), std::stod(argv[3]));
+    else if (modo == "grade" && argc > 3)
+        grafo = CaminhoMinimo::geraGrafoGrade(std::stoull(argv[2]), std::stoull(argv[3]));
+    else if (modo == "rmat" && argc > 3)
+        grafo = CaminhoMinimo::geraGrafoRMAT(std::stoull(argv[2]), std::stod(argv[3]));
+    else if (modo.size() >= 3 && modo.compare(modo.size() - 3, 3, ".gr") == 0)
+        grafo = CaminhoMinimo::leDimacs(modo);
+    else
+        grafo = CaminhoMinimo::leListaArestas(modo);
+    return grafo;
+}
+
+// Modos por linha de comando:
+//   bmssp <arquivo.gr | arquivo de arestas>
+//   bmssp esparso <n> <grau medio>
+//   bmssp grade <linhas> <colunas>
+//   bmssp rmat <escala> <grau medio>
+//   bmssp ordenacao <qualquer um dos modos acima>  (compara as renumerações de vértices)
+//   bmssp camadas <qualquer um dos modos acima>    (BMSSP com cada marcação de camadas do findPivots)
+int executaModo(int argc, char* argv[]) {
+    bool ordenacoes = std::string(argv[1]) == "ordenacao" && argc > 2;
+    bool camadas = std::string(argv[1]) == "camadas" && argc > 2;
+    if (ordenacoes || camadas) {
+        argc--;
+        argv++;
+    }
+
+    auto tempoInicial = std::chrono::high_resolution_clock::now();
+    CaminhoMinimo::GrafoCSR<> grafo = montaGrafo(argc, argv);
+
+    auto tempoPreparo = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - tempoInicial).count();
+    std::cout << "Grafo pronto em " << tempoPreparo << " ms" << std::endl;
+
+    std::string descricao;
+    for (int i = 1; i < argc; i++) descricao += (i > 1 ? " " : "") + std::string(argv[i]);
+    if (camadas) return comparaMarcacaoCamadas(grafo, descricao);
+    return ordenacoes ? comparaOrdenacoes(grafo, descricao) : comparaGrafo(grafo, descricao);
+}
+
+int main(int argc, char* argv[]) {
+    // Com argumentos, compara os algoritmos em um único grafo grande em vez da bateria de grafos densos
+    if (argc > 1) return executaModo(argc, argv);
+
     // Parâmetros iniciais
     int tamanho = 100;
     int origem = 0;
@@ -35,14 +434,14 @@ int main() {
     std::ofstream arquivoCsv(nomeArquivoCsv);
 
     // Escreve o cabeçalho das colunas
-    arquivoCsv << "N_Teste,N_Vertices,Tempo_Dijkstra_micros,Tempo_BMSSP_micros\n";
+    arquivoCsv << "N_Teste,N_Vertices,Tempo_Dijkstra_micros,Tempo_BMSSP_micros,Tempo_Dijkstra_Radix_micros,Tempo_Dijkstra_Dial_micros,Tempo_Dijkstra_Binaria_micros,Tempo_DeltaStepping_micros\n";
 
     // Feedback visual para saber que iniciou
     std::cout << "Iniciando Benchmark..." << std::endl;
     std::cout << "Gerando saida em: " << nomeArquivoCsv << std::endl;
 
     std::vector<InfoErro> errosEncontrados;
-    CaminhoMinimo::Algoritmo algos; // Instancia o Solucionador
+    CaminhoMinimo::Algoritmo<> algos; // Instancia o Solucionador (size_t, double)
 
     for (int i = 0; i < quantidade; i++) {
         // Aumenta o tamanho do grafo a cada stepMudanca iterações
@@ -55,31 +454,50 @@ int main() {
         auto grafo = geraGrafo(tamanho, densidade);
         algos.setGrafo(grafo);
 
-        // 2. EXECUÇÃO DO BMSSP
-        long long tempoBMSSP = algos.execBmssp(origem);
-        const std::vector<double>& resultadoBMSSP = algos.getDist();
-
-        // 3. EXECUÇÃO DO DIJKSTRA
+        // 2. EXECUÇÃO DO DIJKSTRA (referência: é a única cópia, os outros são conferidos direto em getResultado)
         long long tempoDijkstra = algos.execDijkstra(origem);
         std::vector<double> resultadoDijkstra = algos.getDist();
+        size_t verticeDivergente = resultadoDijkstra.size();
+        double valorDivergente = 0;
+        auto confere = [&]() {
+            if (verticeDivergente < resultadoDijkstra.size()) return;
+            verticeDivergente = primeiraDivergencia(algos, resultadoDijkstra);
+            if (verticeDivergente < resultadoDijkstra.size()) valorDivergente = algos.getDist(verticeDivergente);
+        };
 
-        // 4. ESCRITA NO CSV (Teste, Vertices, Dijkstra, BMSSP)
-        arquivoCsv << i << "," << tamanho << "," << tempoDijkstra << "," << tempoBMSSP << "\n";
+        // 3. EXECUÇÃO DO BMSSP
+        long long tempoBMSSP = algos.execBmssp(origem);
+        confere();
 
-        // 5. VALIDAÇÃO (Mantida a lógica de erro, mas sem spammar o console)
-        if (resultadoDijkstra.size() != resultadoBMSSP.size()) {
-            std::cerr << "[ERRO CRITICO] Tamanhos diferentes no teste " << i << std::endl;
-            continue;
-        }
+        // 3b. DIJKSTRA COM RADIX HEAP (baseline mais forte para o BMSSP)
+        algos.setFilaDijkstra(CaminhoMinimo::FilaDijkstra::Radix);
+        long long tempoDijkstraRadix = algos.execDijkstra(origem);
+        confere();
 
-        for (size_t v = 0; v < resultadoDijkstra.size(); ++v) {
-            // Verifica divergência
-            if (resultadoDijkstra[v] != resultadoBMSSP[v]) {
-                errosEncontrados.push_back({ i, tamanho, v, resultadoDijkstra[v], resultadoBMSSP[v] });
-                // Mensagem de erro no console é importante manter
-                std::cerr << "[DIVERGENCIA] Teste " << i << " Vertice " << v << std::endl;
-                break;
-            }
+        // 3c. DIJKSTRA COM BALDES (Dial), com a faixa de pesos medida em setGrafo
+        algos.setFilaDijkstra(CaminhoMinimo::FilaDijkstra::Dial);
+        long long tempoDijkstraDial = algos.execDijkstra(origem);
+        confere();
+
+        // 3d. DIJKSTRA COM O priority_queue ORIGINAL (o padrão agora é o heap d-ário indexado)
+        algos.setFilaDijkstra(CaminhoMinimo::FilaDijkstra::Binaria);
+        long long tempoDijkstraBinaria = algos.execDijkstra(origem);
+        confere();
+        algos.setFilaDijkstra(CaminhoMinimo::FilaDijkstra::DAria);
+
+        // 3e. DELTA-STEPPING PARALELO (todas as threads)
+        double delta = escolheDelta(CaminhoMinimo::PESOMAX, tamanho, static_cast<size_t>(densidade * tamanho * (tamanho - 1)));
+        long long tempoDeltaStepping = algos.execDeltaStepping(origem, delta);
+        confere();
+
+        // 4. ESCRITA NO CSV (Teste, Vertices, Dijkstra, BMSSP, Dijkstra radix, Dijkstra Dial, Dijkstra binário, delta-stepping)
+        arquivoCsv << i << "," << tamanho << "," << tempoDijkstra << "," << tempoBMSSP << "," << tempoDijkstraRadix << "," << tempoDijkstraDial << "," << tempoDijkstraBinaria << "," << tempoDeltaStepping << "\n";
+
+        // 5. VALIDAÇÃO (Mantida a lógica de erro, mas sem spammar o console)
+        if (verticeDivergente < resultadoDijkstra.size()) {
+            errosEncontrados.push_back({ i, tamanho, verticeDivergente, resultadoDijkstra[verticeDivergente], valorDivergente });
+            // Mensagem de erro no console é importante manter
+            std::cerr << "[DIVERGENCIA] Teste " << i << " Vertice " << verticeDivergente << std::endl;
         }
     }
 
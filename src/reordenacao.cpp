@@ -0,0 +1,134 @@
+#include "../headers/reordenacao.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace CaminhoMinimo {
+	// Vértices em ordem de grau de saída (counting sort, estável nos ids)
+	template <typename Vertice, typename Peso>
+	static std::vector<Vertice> ordenaPorGrau(const VisaoCSR<Vertice, Peso>& grafo, bool decrescente)
+	{
+		size_t tamanho = grafo.tamanho();
+		size_t grauMaximo = 0;
+		for (size_t v = 0; v < tamanho; v++)
+			grauMaximo = std::max<size_t>(grauMaximo, grafo.inicios[v + 1] - grafo.inicios[v]);
+
+		std::vector<size_t> contagem(grauMaximo + 2, 0);
+		auto chave = [&](size_t v) {
+			size_t grau = grafo.inicios[v + 1] - grafo.inicios[v];
+			return decrescente ? grauMaximo - grau : grau;
+		};
+		for (size_t v = 0; v < tamanho; v++) contagem[chave(v) + 1]++;
+		for (size_t g = 0; g <= grauMaximo; g++) contagem[g + 1] += contagem[g];
+
+		std::vector<Vertice> ordem(tamanho);
+		for (size_t v = 0; v < tamanho; v++) ordem[contagem[chave(v)]++] = static_cast<Vertice>(v);
+		return ordem;
+	}
+
+	// Busca em largura seguindo as arestas de saída; cada vértice ainda não visitado de raizes
+	// começa uma nova busca. Com porGrau, os vizinhos entram na fila em ordem crescente de grau (Cuthill-McKee).
+	template <typename Vertice, typename Peso>
+	static std::vector<Vertice> ordemLargura(const VisaoCSR<Vertice, Peso>& grafo, const std::vector<Vertice>& raizes, bool porGrau)
+	{
+		size_t tamanho = grafo.tamanho();
+		std::vector<char> visitado(tamanho, false);
+		std::vector<Vertice> ordem;
+		ordem.reserve(tamanho);
+
+		auto grau = [&](Vertice v) { return grafo.inicios[v + 1] - grafo.inicios[v]; };
+
+		for (Vertice raiz : raizes) {
+			if (visitado[raiz]) continue;
+			visitado[raiz] = true;
+			ordem.push_back(raiz);
+
+			// a própria ordem funciona como fila
+			for (size_t cabeca = ordem.size() - 1; cabeca < ordem.size(); cabeca++) {
+				Vertice u = ordem[cabeca];
+				size_t primeiroNovo = ordem.size();
+				for (size_t aresta = grafo.inicios[u]; aresta < grafo.inicios[u + 1]; aresta++) {
+					Vertice v = grafo.destinos[aresta];
+					if (visitado[v]) continue;
+					visitado[v] = true;
+					ordem.push_back(v);
+				}
+				if (porGrau)
+					std::stable_sort(ordem.begin() + primeiroNovo, ordem.end(), [&](Vertice a, Vertice b) { return grau(a) < grau(b); });
+			}
+		}
+		return ordem;
+	}
+
+	template <typename Vertice, typename Peso>
+	std::vector<Vertice> calculaOrdem(const VisaoCSR<Vertice, Peso>& grafo, Ordenacao ordenacao)
+	{
+		size_t tamanho = grafo.tamanho();
+		std::vector<Vertice> ordem; // ordem[novo] = original
+
+		switch (ordenacao) {
+		case Ordenacao::BFS: {
+			std::vector<Vertice> raizes(tamanho);
+			std::iota(raizes.begin(), raizes.end(), Vertice(0));
+			ordem = ordemLargura(grafo, raizes, false);
+			break;
+		}
+		case Ordenacao::RCM:
+			// raízes de grau mínimo aproximam os vértices periféricos; a ordem final é invertida
+			ordem = ordemLargura(grafo, ordenaPorGrau(grafo, false), true);
+			std::reverse(ordem.begin(), ordem.end());
+			break;
+		case Ordenacao::Grau:
+			ordem = ordenaPorGrau(grafo, true);
+			break;
+		default:
+			ordem.resize(tamanho);
+			std::iota(ordem.begin(), ordem.end(), Vertice(0));
+			break;
+		}
+
+		std::vector<Vertice> novoId(tamanho);
+		for (size_t i = 0; i < tamanho; i++) novoId[ordem[i]] = static_cast<Vertice>(i);
+		return novoId;
+	}
+
+	template <typename Vertice, typename Peso>
+	GrafoCSR<Vertice, Peso> permutaGrafo(const VisaoCSR<Vertice, Peso>& grafo, const std::vector<Vertice>& novoId)
+	{
+		size_t tamanho = grafo.tamanho();
+		std::vector<Vertice> ordem(tamanho);
+		for (size_t v = 0; v < tamanho; v++) ordem[novoId[v]] = static_cast<Vertice>(v);
+
+		GrafoCSR<Vertice, Peso> permutado;
+		permutado.inicios.resize(tamanho + 1);
+		permutado.inicios[0] = 0;
+		for (size_t i = 0; i < tamanho; i++)
+			permutado.inicios[i + 1] = permutado.inicios[i] + (grafo.inicios[ordem[i] + 1] - grafo.inicios[ordem[i]]);
+
+		permutado.destinos.resize(grafo.numArestas());
+		permutado.pesos.resize(grafo.numArestas());
+
+		std::vector<std::pair<Vertice, Peso>> vizinhos;
+		for (size_t i = 0; i < tamanho; i++) {
+			Vertice u = ordem[i];
+			vizinhos.clear();
+			for (size_t aresta = grafo.inicios[u]; aresta < grafo.inicios[u + 1]; aresta++)
+				vizinhos.push_back({ novoId[grafo.destinos[aresta]], grafo.pesos[aresta] });
+			std::sort(vizinhos.begin(), vizinhos.end());
+
+			size_t posicao = permutado.inicios[i];
+			for (const auto& [destino, peso] : vizinhos) {
+				permutado.destinos[posicao] = destino;
+				permutado.pesos[posicao] = peso;
+				posicao++;
+			}
+		}
+		return permutado;
+	}
+
+#define INSTANCIA_REORDENACAO(V, P) \
+	template std::vector<V> calculaOrdem<V, P>(const VisaoCSR<V, P>&, Ordenacao); \
+	template GrafoCSR<V, P> permutaGrafo<V, P>(const VisaoCSR<V, P>&, const std::vector<V>&);
+
+	CAMINHOMINIMO_TIPOS(INSTANCIA_REORDENACAO)
+}